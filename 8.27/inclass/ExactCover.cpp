@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "dlx.h"
+
+/*
+ * 用舞蹈链求解N皇后和数独
+ * 用法：ExactCover queens N [all|first]       统计N皇后的解数，或打印第一个解
+ *       ExactCover sudoku <题目文件|-> [all]  逐行求解数独；all时统计每题的解数
+ */
+
+int print_queens(const int *rows, int n, void *ctx)
+{
+    int size = *(int *)ctx, q[64], r, c;
+
+    for (r = 0; r < n; r++)
+        q[rows[r] / size] = rows[r] % size;
+    for (r = 0; r < size; r++) {
+        for (c = 0; c < size; c++)
+            printf("%c ", q[r] == c ? 'Q' : '.');
+        printf("\n");
+    }
+    return 0;
+}
+
+int fill_sudoku(const int *rows, int n, void *ctx)
+{
+    char *text = (char *)ctx;
+    int k;
+
+    for (k = 0; k < n; k++)
+        text[rows[k] / 9] = (char)('1' + rows[k] % 9);
+    return 1;
+}
+
+int run_queens(int n, int first)
+{
+    dlx_t d;
+    clock_t start = clock();
+
+    if (n < 1 || n > 64 || !dlx_encode_queens(&d, n)) {
+        printf("N must be in 1..64\n");
+        return 1;
+    }
+    if (first) {
+        if (dlx_search(&d, 1, print_queens, &n) == 0)
+            printf("no solution\n");
+    }
+    else {
+        long long nCount = dlx_search(&d, 0, NULL, NULL);
+        printf("%d-queens: %lld solutions, %.3fs\n", n, nCount,
+               (double)(clock() - start) / CLOCKS_PER_SEC);
+    }
+    dlx_free(&d);
+    return 0;
+}
+
+int run_sudoku(const char *path, int all)
+{
+    FILE *fp = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    char line[256], text[82];
+    long long nPuzzles = 0, nSolved = 0;
+    clock_t start = clock();
+
+    if (fp == NULL) {
+        printf("cannot open %s\n", path);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        dlx_t d;
+        long long nCount;
+
+        if (strcspn(line, "\r\n") < 81)
+            continue;
+        nPuzzles++;
+        memcpy(text, line, 81);
+        text[81] = '\0';
+        if (!dlx_encode_sudoku(&d, text)) {
+            printf("%s invalid\n", text);
+            continue;
+        }
+        nCount = dlx_search(&d, all ? 0 : 1, fill_sudoku, text);
+        dlx_free(&d);
+        if (nCount > 0)
+            nSolved++;
+        if (all)
+            printf("%s %lld\n", text, nCount);
+        else
+            printf("%s\n", nCount > 0 ? text : "no solution");
+    }
+    if (fp != stdin)
+        fclose(fp);
+
+    fprintf(stderr, "%lld puzzles, %lld solved, %.3fs\n", nPuzzles, nSolved,
+            (double)(clock() - start) / CLOCKS_PER_SEC);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 2 && strcmp(argv[1], "queens") == 0)
+        return run_queens(atoi(argv[2]), argc > 3 && strcmp(argv[3], "first") == 0);
+    if (argc > 2 && strcmp(argv[1], "sudoku") == 0)
+        return run_sudoku(argv[2], argc > 3 && strcmp(argv[3], "all") == 0);
+
+    printf("usage: ExactCover queens N [all|first]\n");
+    printf("       ExactCover sudoku <puzzles|-> [all]\n");
+    return 1;
+}
@@ -1,73 +1,254 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 
-#define MAX_N 8
-#define MAX_NODES 10000*MAX_N			
+/*
+ * 逐层广度优先的N皇后计数
+ * 用法：QueensBFS-ex [N] [每层内存上限MB]
+ *
+ * 不再用固定大小的静态队列：每一层是一个独立的压缩数组，由上一层全部展开后得到，
+ * 展开完成后立即释放上一层。一层的大小超过内存上限时，这一层改写到临时文件中，
+ * 因此边界层比内存大时仍然可以运行
+ *
+ * 每个结点编码成 3N+1 位：列掩码、左对角线掩码、右对角线掩码各N位，最高一位是对称权重
+ * （第一行只放左半边和中间列，左半边的结点计数乘2）
+ */
 
-#define put_node(st) queue[tl++]=st
-#define get_node() queue[hd++]
-#define queue_not_empty (hd<tl)
+#define MAX_N 21                    /* 3*21+1 = 64位 */
+#define CHUNK_BYTES (1 << 16)       /* 溢出到文件时的读写缓冲区大小 */
 
+typedef uint64_t code_t;
 
+typedef struct level_t{
+    unsigned char *buf;     /* 在内存中时保存整层；溢出后作为写缓冲区 */
+    size_t len, cap;
+    FILE *fp;               /* 溢出到磁盘时的临时文件，否则为NULL */
+    long long nNodes;
+    long long nBytes;       /* 整层编码后的字节数 */
+} level_t;
 
-/*
-#define pop() stack[--sp]
-#define push(node) stack[sp++] = node
-#define stack_not_empty (sp>0)
-*/
-typedef struct state_t{
-    short n, q[MAX_N];		
-} state_t;
+typedef struct reader_t{
+    level_t *lv;
+    unsigned char *chunk;   /* 从文件读入的缓冲区 */
+    size_t pos, len;
+} reader_t;
 
-state_t queue[MAX_NODES];
+int n, rec_bytes;
+size_t mem_limit;
 
-int hd=0, tl=0;
+void level_init(level_t *lv)
+{
+    memset(lv, 0, sizeof(*lv));
+}
 
-int queens[MAX_N];
-int conflict(int q, int p, short queens[]);
-int queen(int n); 
-void print_queens(state_t *st); 
+void level_free(level_t *lv)
+{
+    free(lv->buf);
+    if (lv->fp)
+        fclose(lv->fp);
+    level_init(lv);
+}
 
-int main( )
+/* 把内存中的内容转存到临时文件，之后buf只作为写缓冲区 */
+int level_spill(level_t *lv)
 {
-    state_t init_st;
+    lv->fp = tmpfile();
+    if (lv->fp == NULL)
+        return 0;
+    if (lv->len && fwrite(lv->buf, 1, lv->len, lv->fp) != lv->len)
+        return 0;
+    lv->len = 0;
+    if (lv->cap < CHUNK_BYTES) {
+        lv->cap = CHUNK_BYTES;
+        lv->buf = (unsigned char *)realloc(lv->buf, lv->cap);
+    }
+    return lv->buf != NULL;
+}
 
-    init_st.n = 0;
-    push(init_st);
-    queen(MAX_N);
-    return 0;
+int put_node(level_t *lv, code_t code)
+{
+    int i;
+
+    if (lv->fp) {
+        if (lv->len + rec_bytes > lv->cap) {
+            if (fwrite(lv->buf, 1, lv->len, lv->fp) != lv->len)
+                return 0;
+            lv->len = 0;
+        }
+    }
+    else if (lv->len + rec_bytes > lv->cap) {
+        if (lv->len + rec_bytes > mem_limit) {
+            if (!level_spill(lv))
+                return 0;
+        }
+        else {
+            size_t cap = lv->cap ? lv->cap * 2 : CHUNK_BYTES;
+            if (cap > mem_limit)
+                cap = mem_limit;
+            lv->buf = (unsigned char *)realloc(lv->buf, cap);
+            if (lv->buf == NULL)
+                return 0;
+            lv->cap = cap;
+        }
+    }
+
+    for (i = 0; i < rec_bytes; i++)
+        lv->buf[lv->len++] = (unsigned char)(code >> (8 * i));
+    lv->nNodes++;
+    lv->nBytes += rec_bytes;
+    return 1;
+}
+
+/* 写完一层：溢出的层把缓冲区写出并回到文件开头，同时释放写缓冲区 */
+int level_finish(level_t *lv)
+{
+    if (lv->fp == NULL)
+        return 1;
+    if (lv->len && fwrite(lv->buf, 1, lv->len, lv->fp) != lv->len)
+        return 0;
+    free(lv->buf);
+    lv->buf = NULL;
+    lv->len = lv->cap = 0;
+    rewind(lv->fp);
+    return 1;
 }
 
-void print_queens(state_t *st)		
+int get_node(reader_t *rd, code_t *code)
 {
+    level_t *lv = rd->lv;
+    const unsigned char *p;
+    int i;
 
+    if (lv->fp) {
+        if (rd->pos + rec_bytes > rd->len) {
+            /* CHUNK_BYTES不一定是记录长度的整数倍，先把剩下的半条记录移到开头 */
+            size_t rest = rd->len - rd->pos;
+            memmove(rd->chunk, rd->chunk + rd->pos, rest);
+            rd->len = rest + fread(rd->chunk + rest, 1, CHUNK_BYTES - rest, lv->fp);
+            rd->pos = 0;
+            if (rd->len < (size_t)rec_bytes)
+                return 0;
+        }
+        p = rd->chunk + rd->pos;
+    }
+    else {
+        if (rd->pos + rec_bytes > lv->len)
+            return 0;
+        p = lv->buf + rd->pos;
+    }
+    rd->pos += rec_bytes;
+
+    *code = 0;
+    for (i = 0; i < rec_bytes; i++)
+        *code |= (code_t)p[i] << (8 * i);
+    return 1;
+}
+
+code_t encode(uint32_t cols, uint32_t ld, uint32_t rd, int weight2)
+{
+    return (code_t)cols | ((code_t)ld << n) | ((code_t)rd << (2 * n)) | ((code_t)weight2 << (3 * n));
 }
 
-int conflict(int q, int p, short queens[])
+int queen(int n);
+
+int main(int argc, char *argv[])
 {
+    n = argc > 1 ? atoi(argv[1]) : 8;
+    mem_limit = (size_t)((argc > 2 ? atof(argv[2]) : 256) * 1024 * 1024);
+    if (n < 1 || n > MAX_N) {
+        printf("N must be in 1..%d\n", MAX_N);
+        return 1;
+    }
+    if (mem_limit < CHUNK_BYTES)
+        mem_limit = CHUNK_BYTES;
+    rec_bytes = (3 * n + 1 + 7) / 8;
+    queen(n);
     return 0;
 }
 
-int queen(int n)				
+int queen(int n)
 {
-    int i, nCount=0;
-    state_t st;
-
-    while(queue_not_empty){
-        st = get_node();
-        if (st.n>=n)
-        {
-            print_queens(&st);
-            nCount ++;
-            continue;
+    uint32_t full = (n >= 32) ? 0xFFFFFFFFu : ((1u << n) - 1);
+    level_t cur, next;
+    reader_t rd;
+    long long nCount = 0, peak = 0;
+    code_t code;
+    int row, c;
+
+    level_init(&cur);
+    level_init(&next);
+    rd.chunk = (unsigned char *)malloc(CHUNK_BYTES);
+
+    /* 第一层：第一行只放左半边和中间列 */
+    for (c = 0; c < (n + 1) / 2; c++) {
+        uint32_t bit = 1u << c;
+        int weight2 = !(n % 2 == 1 && c == n / 2);
+        if (n == 1) {
+            nCount = 1;
+            break;
         }
-        st.n++;	
-        for(i=0; i<n; i++){ 
-            if (conflict(st.n-1, i, st.q))
+        if (!put_node(&cur, encode(bit, (bit << 1) & full, bit >> 1, weight2)))
+            goto io_error;
+    }
+    if (!level_finish(&cur))
+        goto io_error;
+    if (n > 1)
+        printf("level %2d: %12lld nodes %14lld bytes%s\n", 1, cur.nNodes, cur.nBytes, cur.fp ? " (spilled)" : "");
+
+    for (row = 1; row < n; row++) {
+        long long resident;
+
+        rd.lv = &cur;
+        rd.pos = rd.len = 0;
+        while (get_node(&rd, &code)) {
+            uint32_t cols = (uint32_t)(code & full);
+            uint32_t ld = (uint32_t)((code >> n) & full);
+            uint32_t rdg = (uint32_t)((code >> (2 * n)) & full);
+            int weight2 = (int)((code >> (3 * n)) & 1);
+            uint32_t avail = full & ~(cols | ld | rdg);
+
+            /* 最后一行不用再存下来，候选列的个数就是解的个数 */
+            if (row == n - 1) {
+                while (avail) {
+                    avail &= avail - 1;
+                    nCount += weight2 ? 2 : 1;
+                }
                 continue;
-            st.q[st.n-1] = i;	
-            put_node(st);		
+            }
+            while (avail) {
+                uint32_t bit = avail & (0u - avail);
+                avail ^= bit;
+                if (!put_node(&next, encode(cols | bit, ((ld | bit) << 1) & full, (rdg | bit) >> 1, weight2)))
+                    goto io_error;
+            }
         }
+
+        /* 上一层和新一层同时存在时的内存占用 */
+        resident = (long long)(cur.fp ? CHUNK_BYTES : cur.len) + (long long)next.cap;
+        if (resident > peak)
+            peak = resident;
+        if (!level_finish(&next))
+            goto io_error;
+        if (row < n - 1)
+            printf("level %2d: %12lld nodes %14lld bytes%s, resident peak %lld bytes\n",
+                   row + 1, next.nNodes, next.nBytes, next.fp ? " (spilled)" : "", resident);
+
+        level_free(&cur);
+        cur = next;
+        level_init(&next);
     }
-    printf("%d\n", nCount);
+    level_free(&cur);
+    free(rd.chunk);
+
+    printf("%lld\n", nCount);
+    printf("peak resident frontier %lld bytes\n", peak);
     return 0;
+
+io_error:
+    level_free(&cur);
+    level_free(&next);
+    free(rd.chunk);
+    printf("frontier I/O error\n");
+    return 1;
 }
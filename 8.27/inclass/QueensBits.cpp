@@ -0,0 +1,29 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "queens_bits.h"
+
+/*
+ * 位运算N皇后计数
+ * 用法：QueensBits [N]          统计N皇后的解数（默认8）
+ *       QueensBits [N1] [N2]    依次统计N1到N2皇后的解数
+ */
+int main(int argc, char *argv[])
+{
+    int from = argc > 1 ? atoi(argv[1]) : 8;
+    int to = argc > 2 ? atoi(argv[2]) : from;
+    int n;
+
+    if (from < 1 || to > QB_MAX_N || from > to) {
+        printf("N must be in 1..%d\n", QB_MAX_N);
+        return 1;
+    }
+
+    for (n = from; n <= to; n++) {
+        clock_t start = clock();
+        long long nCount = qb_count(n);
+        double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+        printf("%2d %18lld %10.3fs\n", n, nCount, seconds);
+    }
+    return 0;
+}
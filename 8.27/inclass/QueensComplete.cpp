@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+#include "queens_bits.h"
+
+/*
+ * 带约束的N皇后补全
+ * 用法：QueensComplete <count|text|binary> [棋盘文件] [最多输出的解数]
+ *
+ * 棋盘文件每行一行棋盘，'Q'为预先放置的皇后，'x'为禁止放置的格子，'.'为空格子，
+ * 行数即为N；不给文件时从标准输入读。例如：
+ *   ..Q.....
+ *   ........
+ *   x.......
+ *
+ * count   只输出解的个数
+ * text    每行一个解，依次为第0..N-1行皇后的列号
+ * binary  每个解N个字节，依次为第0..N-1行皇后的列号
+ * 解边找边写出，不在内存中保存；text/binary模式下解的个数写到标准错误
+ */
+
+typedef struct output_t{
+    int binary;
+    long long limit;        /* 最多输出的解数，0表示不限 */
+    long long nWritten;
+} output_t;
+
+int write_solution(const int *q, int n, void *ctx)
+{
+    output_t *out = (output_t *)ctx;
+    char line[QB_MAX_N * 3 + 1];
+    int r, len = 0;
+
+    if (out->binary) {
+        for (r = 0; r < n; r++)
+            line[r] = (char)q[r];
+        len = n;
+    }
+    else {
+        for (r = 0; r < n; r++) {
+            if (q[r] >= 10)
+                line[len++] = (char)('0' + q[r] / 10);
+            line[len++] = (char)('0' + q[r] % 10);
+            line[len++] = r == n - 1 ? '\n' : ' ';
+        }
+    }
+    fwrite(line, 1, len, stdout);
+
+    out->nWritten++;
+    return out->limit == 0 || out->nWritten < out->limit;
+}
+
+/* 读入棋盘，返回0表示格式错误 */
+int read_board(FILE *fp, qb_board_t *b)
+{
+    char line[256];
+    int r = 0, c, width = -1;
+
+    qb_board_init(b, 0);
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        int len = (int)strcspn(line, "\r\n");
+        if (len == 0)
+            continue;
+        if (r >= QB_MAX_N || len > QB_MAX_N || (width >= 0 && len != width))
+            return 0;
+        width = len;
+        for (c = 0; c < len; c++) {
+            if (line[c] == 'Q') {
+                if (b->fixed[r] >= 0)
+                    return 0;
+                b->fixed[r] = c;
+            }
+            else if (line[c] == 'x')
+                b->blocked[r] |= 1u << c;
+            else if (line[c] != '.')
+                return 0;
+        }
+        r++;
+    }
+    b->n = r;
+    return r > 0 && r == width;
+}
+
+int main(int argc, char *argv[])
+{
+    static char out_buf[1 << 16];
+    qb_board_t board;
+    output_t out;
+    const char *mode = argc > 1 ? argv[1] : "count";
+    FILE *fp = stdin;
+    long long nCount;
+
+    if (strcmp(mode, "count") != 0 && strcmp(mode, "text") != 0 && strcmp(mode, "binary") != 0) {
+        printf("usage: QueensComplete <count|text|binary> [board] [limit]\n");
+        return 1;
+    }
+    if (argc > 2 && strcmp(argv[2], "-") != 0) {
+        fp = fopen(argv[2], "r");
+        if (fp == NULL) {
+            printf("cannot open %s\n", argv[2]);
+            return 1;
+        }
+    }
+    if (!read_board(fp, &board)) {
+        printf("board must be N lines of N characters from '.', 'Q', 'x' (N <= %d)\n", QB_MAX_N);
+        return 1;
+    }
+    if (fp != stdin)
+        fclose(fp);
+
+    if (strcmp(mode, "count") == 0) {
+        printf("%lld\n", qb_solve_board(&board, NULL, NULL));
+        return 0;
+    }
+
+    out.binary = strcmp(mode, "binary") == 0;
+    out.limit = argc > 3 ? atoll(argv[3]) : 0;
+    out.nWritten = 0;
+#ifdef _WIN32
+    if (out.binary)
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    setvbuf(stdout, out_buf, _IOFBF, sizeof(out_buf));
+    nCount = qb_solve_board(&board, write_solution, &out);
+    fflush(stdout);
+    fprintf(stderr, "%lld solutions\n", nCount);
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "queens_bits.h"
+
+/*
+ * 并行N皇后计数（支持断点续算）
+ * 用法：QueensParallel N [k] [线程数] [断点文件]
+ *
+ * 把前k行的所有合法放法作为互相独立的子问题，在工作窃取线程池上计数；
+ * 每完成一个子问题就把结果追加到断点文件，进程被杀掉后用同样的参数重新运行即可从断点继续
+ *
+ * 断点文件格式：
+ *   第一行    N k 子问题总数
+ *   之后每行  子问题编号 该子问题的解数（已乘对称权重）
+ */
+
+typedef struct task_t{
+    qb_state_t st;
+    int weight;     /* 第一行在左半边的子问题权重为2，中间列为1 */
+} task_t;
+
+/* 枚举前k行的所有合法放法，第一行只取左半边和中间列 */
+static void build_tasks(int n, int k, std::vector<task_t> &tasks)
+{
+    std::vector<task_t> level, next;
+    qb_state_t init_st = qb_empty_state();
+    int c, row;
+
+    for (c = 0; c < (n + 1) / 2; c++) {
+        task_t t;
+        t.st = qb_place(n, &init_st, 1u << c);
+        t.weight = (n % 2 == 1 && c == n / 2) ? 1 : 2;
+        level.push_back(t);
+    }
+
+    for (row = 1; row < k; row++) {
+        next.clear();
+        for (size_t i = 0; i < level.size(); i++) {
+            qmask_t avail = qb_candidates(n, &level[i].st);
+            while (avail) {
+                qmask_t bit = avail & (0u - avail);
+                task_t t;
+                avail ^= bit;
+                t.st = qb_place(n, &level[i].st, bit);
+                t.weight = level[i].weight;
+                next.push_back(t);
+            }
+        }
+        level.swap(next);
+    }
+    tasks.swap(level);
+}
+
+/*
+ * 读取断点文件，返回已完成的子问题数
+ * 只接受以换行结尾的完整记录，被中断时写了一半的最后一行会被丢弃；
+ * 文件头与当前参数不一致时返回-1
+ */
+static long long load_checkpoint(const char *path, int n, int k, size_t nTasks,
+                                 std::vector<char> &done, std::vector<long long> &counts)
+{
+    FILE *fp = fopen(path, "r");
+    char line[128];
+    int fn, fk;
+    size_t ft;
+    long long nDone = 0;
+
+    if (fp == NULL)
+        return 0;
+
+    if (fgets(line, sizeof(line), fp) == NULL) {
+        fclose(fp);
+        return 0;
+    }
+    if (sscanf(line, "%d %d %zu", &fn, &fk, &ft) != 3 || fn != n || fk != k || ft != nTasks) {
+        fclose(fp);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        size_t id;
+        long long nCount;
+        if (strchr(line, '\n') == NULL)
+            break;
+        if (sscanf(line, "%zu %lld", &id, &nCount) != 2 || id >= nTasks)
+            continue;
+        if (!done[id]) {
+            done[id] = 1;
+            counts[id] = nCount;
+            nDone++;
+        }
+    }
+    fclose(fp);
+    return nDone;
+}
+
+/* 只保留有效记录重写断点文件（先写临时文件再改名），返回用于追加的文件指针 */
+static FILE *rewrite_checkpoint(const char *path, int n, int k, size_t nTasks,
+                                const std::vector<char> &done, const std::vector<long long> &counts)
+{
+    char tmp_path[1024];
+    FILE *fp;
+
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    fp = fopen(tmp_path, "w");
+    if (fp == NULL)
+        return NULL;
+    fprintf(fp, "%d %d %zu\n", n, k, nTasks);
+    for (size_t i = 0; i < nTasks; i++)
+        if (done[i])
+            fprintf(fp, "%zu %lld\n", i, counts[i]);
+    fclose(fp);
+
+    remove(path);
+    if (rename(tmp_path, path) != 0)
+        return NULL;
+    return fopen(path, "a");
+}
+
+/* 每个工作线程一个双端队列：自己从尾部取，窃取时从别人的头部取 */
+typedef struct worker_queue_t{
+    std::mutex m;
+    std::deque<size_t> ids;
+} worker_queue_t;
+
+static bool pop_task(std::vector<worker_queue_t> &queues, int self, size_t &id)
+{
+    int nWorkers = (int)queues.size();
+
+    {
+        std::lock_guard<std::mutex> lock(queues[self].m);
+        if (!queues[self].ids.empty()) {
+            id = queues[self].ids.back();
+            queues[self].ids.pop_back();
+            return true;
+        }
+    }
+    for (int i = 1; i < nWorkers; i++) {
+        worker_queue_t &victim = queues[(self + i) % nWorkers];
+        std::lock_guard<std::mutex> lock(victim.m);
+        if (!victim.ids.empty()) {
+            id = victim.ids.front();
+            victim.ids.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 8;
+    int k = argc > 2 ? atoi(argv[2]) : (n > 4 ? 4 : n);
+    int nWorkers = argc > 3 ? atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+    char default_path[64];
+    const char *path;
+    std::vector<task_t> tasks;
+    std::vector<char> done;
+    std::vector<long long> counts;
+    long long nDone, total = 0;
+    FILE *ckpt;
+
+    if (n < 1 || n > QB_MAX_N || k < 1 || k > n) {
+        printf("N must be in 1..%d and k in 1..N\n", QB_MAX_N);
+        return 1;
+    }
+    if (nWorkers < 1)
+        nWorkers = 1;
+    snprintf(default_path, sizeof(default_path), "queens_%d.ckpt", n);
+    path = argc > 4 ? argv[4] : default_path;
+
+    build_tasks(n, k, tasks);
+    done.assign(tasks.size(), 0);
+    counts.assign(tasks.size(), 0);
+
+    nDone = load_checkpoint(path, n, k, tasks.size(), done, counts);
+    if (nDone < 0) {
+        printf("checkpoint %s was written for different N/k, remove it or pass another path\n", path);
+        return 1;
+    }
+    ckpt = rewrite_checkpoint(path, n, k, tasks.size(), done, counts);
+    if (ckpt == NULL) {
+        printf("cannot write checkpoint %s\n", path);
+        return 1;
+    }
+    printf("N=%d k=%d: %zu subproblems, %lld already done, %d threads\n",
+           n, k, tasks.size(), nDone, nWorkers);
+
+    /* 未完成的子问题轮流分给各线程 */
+    std::vector<worker_queue_t> queues(nWorkers);
+    size_t next = 0;
+    for (size_t i = 0; i < tasks.size(); i++)
+        if (!done[i])
+            queues[next++ % nWorkers].ids.push_back(i);
+
+    std::mutex ckpt_mutex;
+    std::atomic<long long> nFinished(nDone);
+    time_t start = time(NULL);
+    std::vector<std::thread> workers;
+
+    for (int w = 0; w < nWorkers; w++) {
+        workers.emplace_back([&, w]() {
+            size_t id;
+            while (pop_task(queues, w, id)) {
+                long long nCount = tasks[id].weight * qb_count_from(n, tasks[id].st);
+                counts[id] = nCount;
+                {
+                    std::lock_guard<std::mutex> lock(ckpt_mutex);
+                    fprintf(ckpt, "%zu %lld\n", id, nCount);
+                    fflush(ckpt);
+                }
+                nFinished++;
+            }
+        });
+    }
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+    fclose(ckpt);
+
+    for (size_t i = 0; i < tasks.size(); i++)
+        total += counts[i];
+    printf("%d-queens: %lld solutions (%lld subproblems, %lds)\n",
+           n, total, nFinished.load(), (long)(time(NULL) - start));
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sudoku_bits.h"
+
+/*
+ * 数独求解
+ * 用法：SudokuDFS <题目文件|-> [线程数] [答案文件]
+ *
+ * 题目文件每行一道题（81个字符，'.'或'0'为空格），'-'表示从标准输入读；
+ * 多道题按块分给各线程求解，最后输出求解速度（题/秒）。
+ * 给出答案文件时按题目顺序写出答案，无解或格式错误的题写出原题
+ * 只有一道题时直接打印棋盘
+ */
+
+#define BATCH_BLOCK 256     /* 每个线程一次领取的题目数 */
+
+void print_board(const char *text)
+{
+    int r, c;
+    for (r = 0; r < 9; r++) {
+        if (r % 3 == 0)
+            printf("+-------+-------+-------+\n");
+        for (c = 0; c < 9; c++)
+            printf("%s%c ", c % 3 == 0 ? "| " : "", text[r * 9 + c]);
+        printf("|\n");
+    }
+    printf("+-------+-------+-------+\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int nThreads = argc > 2 ? atoi(argv[2]) : (int)std::thread::hardware_concurrency();
+    FILE *fp = stdin;
+    std::vector<std::string> puzzles, answers;
+    char line[256];
+
+    if (argc < 2) {
+        printf("usage: SudokuDFS <puzzles|-> [threads] [solutions]\n");
+        return 1;
+    }
+    if (strcmp(argv[1], "-") != 0) {
+        fp = fopen(argv[1], "r");
+        if (fp == NULL) {
+            printf("cannot open %s\n", argv[1]);
+            return 1;
+        }
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (strcspn(line, "\r\n") >= 81)
+            puzzles.push_back(std::string(line, 81));
+    }
+    if (fp != stdin)
+        fclose(fp);
+    if (nThreads < 1)
+        nThreads = 1;
+
+    answers.assign(puzzles.size(), std::string());
+    std::atomic<size_t> next(0);
+    std::atomic<long long> nSolved(0);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < nThreads; t++) {
+        workers.emplace_back([&]() {
+            sd_state_t st, solution;
+            char text[82];
+            long long solved = 0;
+            size_t begin;
+            while ((begin = next.fetch_add(BATCH_BLOCK)) < puzzles.size()) {
+                size_t end = begin + BATCH_BLOCK < puzzles.size() ? begin + BATCH_BLOCK : puzzles.size();
+                for (size_t i = begin; i < end; i++) {
+                    if (sd_parse(puzzles[i].c_str(), &st) && sd_solve(&st, &solution)) {
+                        sd_format(&solution, text);
+                        answers[i] = text;
+                        solved++;
+                    }
+                    else
+                        answers[i] = puzzles[i];
+                }
+            }
+            nSolved += solved;
+        });
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (puzzles.size() == 1)
+        print_board(answers[0].c_str());
+    if (argc > 3) {
+        FILE *out = fopen(argv[3], "w");
+        if (out == NULL) {
+            printf("cannot write %s\n", argv[3]);
+            return 1;
+        }
+        for (size_t i = 0; i < answers.size(); i++)
+            fprintf(out, "%s\n", answers[i].c_str());
+        fclose(out);
+    }
+
+    printf("%zu puzzles, %lld solved, %d threads, %.3fs, %.0f puzzles/s\n",
+           puzzles.size(), nSolved.load(), nThreads, seconds,
+           seconds > 0 ? puzzles.size() / seconds : 0.0);
+    return 0;
+}
@@ -0,0 +1,248 @@
+#ifndef DLX_H
+#define DLX_H
+
+/*
+ * 舞蹈链（Dancing Links）精确覆盖
+ * 所有结点放在连续的数组里，L/R/U/D存的是下标而不是指针：
+ * 0号结点为表头，1..nCols号为列头，之后依次是各行的结点
+ *
+ * 主列必须恰好覆盖一次；次列（如N皇后的对角线）至多覆盖一次，
+ * 次列的列头不挂在表头的横向链表中，因此不会被选作分支列
+ */
+
+#include <stdlib.h>
+
+typedef struct dlx_t{
+    int nPrimary, nCols;
+    int nNodes, maxNodes;
+    int *L, *R, *U, *D;
+    int *C;                 /* 结点所在的列头 */
+    int *S;                 /* 列中剩余的结点数 */
+    int *rowId;             /* 结点所属的行号 */
+    int *O;                 /* 搜索时每层选中的结点 */
+    int *rows;              /* 回调时传出的行号 */
+} dlx_t;
+
+/* 每找到一个解调用一次，rows为选中的行号；返回0时停止搜索 */
+typedef int (*dlx_visit_t)(const int *rows, int n, void *ctx);
+
+static inline void dlx_free(dlx_t *d)
+{
+    free(d->L);
+    free(d->R);
+    free(d->U);
+    free(d->D);
+    free(d->C);
+    free(d->S);
+    free(d->rowId);
+    free(d->O);
+    free(d->rows);
+}
+
+/* 建立nPrimary个主列和nSecondary个次列，maxRowNodes为所有行的结点总数上限 */
+static inline int dlx_init(dlx_t *d, int nPrimary, int nSecondary, int maxRowNodes)
+{
+    int c, n;
+
+    d->nPrimary = nPrimary;
+    d->nCols = nPrimary + nSecondary;
+    d->nNodes = d->nCols + 1;
+    d->maxNodes = d->nNodes + maxRowNodes;
+    n = d->maxNodes;
+    d->L = (int *)malloc(n * sizeof(int));
+    d->R = (int *)malloc(n * sizeof(int));
+    d->U = (int *)malloc(n * sizeof(int));
+    d->D = (int *)malloc(n * sizeof(int));
+    d->C = (int *)malloc(n * sizeof(int));
+    d->S = (int *)malloc((d->nCols + 1) * sizeof(int));
+    d->rowId = (int *)malloc(n * sizeof(int));
+    d->O = (int *)malloc((d->nCols + 1) * sizeof(int));
+    d->rows = (int *)malloc((d->nCols + 1) * sizeof(int));
+    if (!d->L || !d->R || !d->U || !d->D || !d->C || !d->S || !d->rowId || !d->O || !d->rows) {
+        dlx_free(d);
+        return 0;
+    }
+
+    for (c = 0; c <= d->nCols; c++) {
+        d->U[c] = d->D[c] = d->C[c] = c;
+        d->S[c] = 0;
+        d->rowId[c] = -1;
+        if (c <= nPrimary) {
+            d->L[c] = c == 0 ? nPrimary : c - 1;
+            d->R[c] = c == nPrimary ? 0 : c + 1;
+        }
+        else
+            d->L[c] = d->R[c] = c;
+    }
+    return 1;
+}
+
+/* 加入一行，cols为该行覆盖的列（从0开始编号，次列排在主列之后） */
+static inline int dlx_add_row(dlx_t *d, int id, const int *cols, int k)
+{
+    int j, first = d->nNodes;
+
+    if (k <= 0 || d->nNodes + k > d->maxNodes)
+        return 0;
+    for (j = 0; j < k; j++) {
+        int x = d->nNodes++, c = cols[j] + 1;
+        d->C[x] = c;
+        d->rowId[x] = id;
+        d->U[x] = d->U[c];
+        d->D[x] = c;
+        d->D[d->U[c]] = x;
+        d->U[c] = x;
+        d->S[c]++;
+        d->L[x] = j == 0 ? x + k - 1 : x - 1;
+        d->R[x] = j == k - 1 ? first : x + 1;
+    }
+    return 1;
+}
+
+static inline void dlx_cover(dlx_t *d, int c)
+{
+    int i, j;
+
+    d->L[d->R[c]] = d->L[c];
+    d->R[d->L[c]] = d->R[c];
+    for (i = d->D[c]; i != c; i = d->D[i])
+        for (j = d->R[i]; j != i; j = d->R[j]) {
+            d->U[d->D[j]] = d->U[j];
+            d->D[d->U[j]] = d->D[j];
+            d->S[d->C[j]]--;
+        }
+}
+
+static inline void dlx_uncover(dlx_t *d, int c)
+{
+    int i, j;
+
+    for (i = d->U[c]; i != c; i = d->U[i])
+        for (j = d->L[i]; j != i; j = d->L[j]) {
+            d->S[d->C[j]]++;
+            d->U[d->D[j]] = j;
+            d->D[d->U[j]] = j;
+        }
+    d->L[d->R[c]] = c;
+    d->R[d->L[c]] = c;
+}
+
+/*
+ * Knuth的X算法，用O[]作显式栈而不是递归
+ * maxSolutions为0时枚举全部解，为1时找到第一个解就停；visit可以为NULL（只计数）
+ * 返回找到的解数。搜索结束后链表恢复原状，可以再次搜索
+ */
+static inline long long dlx_search(dlx_t *d, long long maxSolutions, dlx_visit_t visit, void *ctx)
+{
+    long long nCount = 0;
+    int level = 0, c, r, j;
+
+forward:
+    if (d->R[0] == 0) {
+        int k;
+        for (k = 0; k < level; k++)
+            d->rows[k] = d->rowId[d->O[k]];
+        nCount++;
+        if ((visit && !visit(d->rows, level, ctx)) || (maxSolutions && nCount >= maxSolutions))
+            goto unwind;
+        goto backtrack;
+    }
+
+    /* 选剩余结点最少的主列 */
+    c = d->R[0];
+    for (j = d->R[c]; j != 0; j = d->R[j])
+        if (d->S[j] < d->S[c])
+            c = j;
+    if (d->S[c] == 0)
+        goto backtrack;
+
+    dlx_cover(d, c);
+    r = d->D[c];
+
+try_row:
+    if (r == c) {
+        dlx_uncover(d, c);
+        goto backtrack;
+    }
+    d->O[level] = r;
+    for (j = d->R[r]; j != r; j = d->R[j])
+        dlx_cover(d, d->C[j]);
+    level++;
+    goto forward;
+
+backtrack:
+    if (level == 0)
+        return nCount;
+    level--;
+    r = d->O[level];
+    c = d->C[r];
+    for (j = d->L[r]; j != r; j = d->L[j])
+        dlx_uncover(d, d->C[j]);
+    r = d->D[r];
+    goto try_row;
+
+unwind:
+    /* 提前停止时逐层撤销覆盖，把链表恢复原状 */
+    while (level > 0) {
+        level--;
+        r = d->O[level];
+        for (j = d->L[r]; j != r; j = d->L[j])
+            dlx_uncover(d, d->C[j]);
+        dlx_uncover(d, d->C[r]);
+    }
+    return nCount;
+}
+
+/*
+ * N皇后编码：主列为N行、N列，次列为2N-1条主对角线和2N-1条副对角线；
+ * 行号 r*N+c 表示第r行第c列放皇后
+ */
+static inline int dlx_encode_queens(dlx_t *d, int n)
+{
+    int r, c;
+
+    if (!dlx_init(d, 2 * n, 2 * (2 * n - 1), 4 * n * n))
+        return 0;
+    for (r = 0; r < n; r++)
+        for (c = 0; c < n; c++) {
+            int cols[4];
+            cols[0] = r;
+            cols[1] = n + c;
+            cols[2] = 2 * n + r + c;
+            cols[3] = 2 * n + (2 * n - 1) + (r - c + n - 1);
+            dlx_add_row(d, r * n + c, cols, 4);
+        }
+    return 1;
+}
+
+/*
+ * 数独编码：324个主列，依次为格子有数、行-数字、列-数字、宫-数字；
+ * 行号 i*9+(v-1) 表示第i格填v。已知数的格子只加入对应的那一行
+ * 题目为81个字符，'.'或'0'为空格，格式错误时返回0
+ */
+static inline int dlx_encode_sudoku(dlx_t *d, const char *text)
+{
+    int i, v;
+
+    for (i = 0; i < 81; i++)
+        if (text[i] != '.' && (text[i] < '0' || text[i] > '9'))
+            return 0;
+    if (!dlx_init(d, 324, 0, 729 * 4))
+        return 0;
+    for (i = 0; i < 81; i++) {
+        int r = i / 9, c = i % 9, b = (r / 3) * 3 + c / 3;
+        for (v = 1; v <= 9; v++) {
+            int cols[4];
+            if (text[i] >= '1' && text[i] <= '9' && text[i] - '0' != v)
+                continue;
+            cols[0] = i;
+            cols[1] = 81 + r * 9 + v - 1;
+            cols[2] = 162 + c * 9 + v - 1;
+            cols[3] = 243 + b * 9 + v - 1;
+            dlx_add_row(d, i * 9 + v - 1, cols, 4);
+        }
+    }
+    return 1;
+}
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef QUEENS_BITS_H
+#define QUEENS_BITS_H
+
+/*
+ * 位运算N皇后引擎
+ * 列、左对角线、右对角线各用一个掩码表示，第i位为1表示该行第i列被攻击；
+ * 每一行的候选列 = ~(cols | ld | rd)，用 x & -x 逐个取出最低位的候选
+ */
+
+#include <stdint.h>
+
+#define QB_MAX_N 32
+
+typedef uint32_t qmask_t;
+
+typedef struct qb_state_t{
+    int row;                /* 已放置皇后的行数 */
+    qmask_t cols, ld, rd;   /* 被占用的列、被左对角线攻击的列、被右对角线攻击的列 */
+} qb_state_t;
+
+/* 低n位全为1的掩码 */
+static inline qmask_t qb_full(int n)
+{
+    return n >= 32 ? 0xFFFFFFFFu : ((1u << n) - 1);
+}
+
+static inline int qb_popcount(qmask_t x)
+{
+    int c = 0;
+    while (x) {
+        x &= x - 1;
+        c++;
+    }
+    return c;
+}
+
+/* 最低位的1所在的列号 */
+static inline int qb_lowest_col(qmask_t bit)
+{
+    int c = 0;
+    while (!(bit & 1u)) {
+        bit >>= 1;
+        c++;
+    }
+    return c;
+}
+
+static inline qb_state_t qb_empty_state(void)
+{
+    qb_state_t st;
+    st.row = 0;
+    st.cols = st.ld = st.rd = 0;
+    return st;
+}
+
+/* 当前行可以放置皇后的列 */
+static inline qmask_t qb_candidates(int n, const qb_state_t *st)
+{
+    return qb_full(n) & ~(st->cols | st->ld | st->rd);
+}
+
+/* 在当前行放置皇后（bit为只有一位为1的列掩码），返回下一行的状态 */
+static inline qb_state_t qb_place(int n, const qb_state_t *st, qmask_t bit)
+{
+    qb_state_t next;
+    next.row = st->row + 1;
+    next.cols = st->cols | bit;
+    next.ld = ((st->ld | bit) << 1) & qb_full(n);
+    next.rd = (st->rd | bit) >> 1;
+    return next;
+}
+
+/*
+ * 从给定状态出发统计完整解的个数
+ * 用显式栈做DFS：栈的第k层保存第row+k行还没尝试过的候选列，
+ * 到最后一行时候选列的个数就是解的个数，不再逐个展开
+ */
+static inline long long qb_count_from(int n, qb_state_t st)
+{
+    qmask_t full = qb_full(n);
+    qmask_t cols[QB_MAX_N + 1], ld[QB_MAX_N + 1], rd[QB_MAX_N + 1], avail[QB_MAX_N + 1];
+    int sp = 0, last = n - 1 - st.row;
+    long long nCount = 0;
+
+    if (st.row >= n)
+        return 1;
+
+    cols[0] = st.cols;
+    ld[0] = st.ld;
+    rd[0] = st.rd;
+    avail[0] = full & ~(st.cols | st.ld | st.rd);
+
+    while (sp >= 0) {
+        qmask_t a = avail[sp], bit;
+        if (sp == last) {
+            nCount += qb_popcount(a);
+            sp--;
+            continue;
+        }
+        if (!a) {
+            sp--;
+            continue;
+        }
+        bit = a & (0u - a);
+        avail[sp] = a ^ bit;
+
+        cols[sp + 1] = cols[sp] | bit;
+        ld[sp + 1] = ((ld[sp] | bit) << 1) & full;
+        rd[sp + 1] = (rd[sp] | bit) >> 1;
+        avail[sp + 1] = full & ~(cols[sp + 1] | ld[sp + 1] | rd[sp + 1]);
+        sp++;
+    }
+    return nCount;
+}
+
+/*
+ * 统计n皇后的解数，利用左右镜像对称只搜索一半：
+ * 第一行皇后在左半边的解各对应一个镜像解，计数乘2；n为奇数时第一行在中间列的解单独计数
+ */
+static inline long long qb_count(int n)
+{
+    qb_state_t init_st = qb_empty_state();
+    long long total = 0;
+    int c;
+
+    if (n <= 0 || n > QB_MAX_N)
+        return 0;
+
+    for (c = 0; c < n / 2; c++)
+        total += 2 * qb_count_from(n, qb_place(n, &init_st, 1u << c));
+    if (n % 2 == 1)
+        total += qb_count_from(n, qb_place(n, &init_st, 1u << (n / 2)));
+    return total;
+}
+
+/*
+ * 带约束的局面：部分皇后已经放好，部分格子禁止放置
+ * fixed[r]为第r行预先放置的皇后列号（-1表示没有），blocked[r]为第r行禁止放置的列
+ */
+typedef struct qb_board_t{
+    int n;
+    int fixed[QB_MAX_N];
+    qmask_t blocked[QB_MAX_N];
+} qb_board_t;
+
+/* 每找到一个解调用一次，q[r]为第r行皇后的列号；返回0时停止搜索 */
+typedef int (*qb_visit_t)(const int *q, int n, void *ctx);
+
+static inline void qb_board_init(qb_board_t *b, int n)
+{
+    int r;
+    b->n = n;
+    for (r = 0; r < QB_MAX_N; r++) {
+        b->fixed[r] = -1;
+        b->blocked[r] = 0;
+    }
+}
+
+/*
+ * 把预先放置的皇后对其他行的攻击并入每一行的禁止掩码
+ * 预先放置的皇后互相攻击或放在禁止格子上时返回0（无解）
+ */
+static inline int qb_board_forbidden(const qb_board_t *b, qmask_t forbid[])
+{
+    int n = b->n, r, s;
+
+    for (r = 0; r < n; r++)
+        forbid[r] = b->blocked[r];
+    for (s = 0; s < n; s++) {
+        int c = b->fixed[s];
+        if (c < 0)
+            continue;
+        for (r = 0; r < n; r++) {
+            int d = r > s ? r - s : s - r;
+            if (r == s)
+                continue;
+            forbid[r] |= 1u << c;
+            if (c - d >= 0)
+                forbid[r] |= 1u << (c - d);
+            if (c + d < n)
+                forbid[r] |= 1u << (c + d);
+        }
+    }
+    for (r = 0; r < n; r++)
+        if (b->fixed[r] >= 0 && (forbid[r] & (1u << b->fixed[r])))
+            return 0;
+    return 1;
+}
+
+/*
+ * 求带约束局面的所有补全
+ * visit为NULL时只计数（最后一行直接数候选列），否则逐个解回调，不保存任何解；
+ * 返回找到的解数（回调要求停止时为停止前的解数）
+ */
+static inline long long qb_solve_board(const qb_board_t *b, qb_visit_t visit, void *ctx)
+{
+    int n = b->n, sp = 0;
+    qmask_t full = qb_full(n), forbid[QB_MAX_N];
+    qmask_t cols[QB_MAX_N + 1], ld[QB_MAX_N + 1], rd[QB_MAX_N + 1], avail[QB_MAX_N + 1];
+    int q[QB_MAX_N];
+    long long nCount = 0;
+
+    if (n <= 0 || n > QB_MAX_N || !qb_board_forbidden(b, forbid))
+        return 0;
+
+    cols[0] = ld[0] = rd[0] = 0;
+    avail[0] = full & ~forbid[0];
+    if (b->fixed[0] >= 0)
+        avail[0] &= 1u << b->fixed[0];
+
+    while (sp >= 0) {
+        qmask_t a = avail[sp], bit;
+        if (!a) {
+            sp--;
+            continue;
+        }
+        if (sp == n - 1 && visit == NULL) {
+            nCount += qb_popcount(a);
+            sp--;
+            continue;
+        }
+        bit = a & (0u - a);
+        avail[sp] = a ^ bit;
+        q[sp] = qb_lowest_col(bit);
+
+        if (sp == n - 1) {
+            nCount++;
+            if (!visit(q, n, ctx))
+                return nCount;
+            continue;
+        }
+
+        cols[sp + 1] = cols[sp] | bit;
+        ld[sp + 1] = ((ld[sp] | bit) << 1) & full;
+        rd[sp + 1] = (rd[sp] | bit) >> 1;
+        avail[sp + 1] = full & ~(cols[sp + 1] | ld[sp + 1] | rd[sp + 1] | forbid[sp + 1]);
+        if (b->fixed[sp + 1] >= 0)
+            avail[sp + 1] &= 1u << b->fixed[sp + 1];
+        sp++;
+    }
+    return nCount;
+}
+
+#endif
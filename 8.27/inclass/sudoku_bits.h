@@ -0,0 +1,226 @@
+#ifndef SUDOKU_BITS_H
+#define SUDOKU_BITS_H
+
+/*
+ * 位运算数独求解
+ * 每一行、列、宫用一个9位掩码记录已填的数字，格子的候选 = ~(行 | 列 | 宫)；
+ * 搜索沿用QueensDFS的显式栈：每次弹出一个状态，先做唯一候选/隐性唯一推理，
+ * 再选候选最少的格子（MRV），把每种填法作为新状态压栈
+ */
+
+#include <string.h>
+
+#define SD_ALL 0x1FF
+#define SD_MAX_NODES (81 * 9)
+
+#define sd_pop() stack[--sp]
+#define sd_push(node) stack[sp++] = node
+#define sd_stack_not_empty (sp > 0)
+
+typedef struct sd_state_t{
+    unsigned char cell[81];                 /* 0表示空格，否则为1..9 */
+    unsigned short row[9], col[9], box[9];  /* 已填数字的掩码，第d-1位表示数字d */
+    int nFilled;
+} sd_state_t;
+
+/* 27个单元（9行、9列、9宫）包含的格子 */
+static const unsigned char SD_UNITS[27][9] = {
+    { 0,  1,  2,  3,  4,  5,  6,  7,  8},
+    { 9, 10, 11, 12, 13, 14, 15, 16, 17},
+    {18, 19, 20, 21, 22, 23, 24, 25, 26},
+    {27, 28, 29, 30, 31, 32, 33, 34, 35},
+    {36, 37, 38, 39, 40, 41, 42, 43, 44},
+    {45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {54, 55, 56, 57, 58, 59, 60, 61, 62},
+    {63, 64, 65, 66, 67, 68, 69, 70, 71},
+    {72, 73, 74, 75, 76, 77, 78, 79, 80},
+    { 0,  9, 18, 27, 36, 45, 54, 63, 72},
+    { 1, 10, 19, 28, 37, 46, 55, 64, 73},
+    { 2, 11, 20, 29, 38, 47, 56, 65, 74},
+    { 3, 12, 21, 30, 39, 48, 57, 66, 75},
+    { 4, 13, 22, 31, 40, 49, 58, 67, 76},
+    { 5, 14, 23, 32, 41, 50, 59, 68, 77},
+    { 6, 15, 24, 33, 42, 51, 60, 69, 78},
+    { 7, 16, 25, 34, 43, 52, 61, 70, 79},
+    { 8, 17, 26, 35, 44, 53, 62, 71, 80},
+    { 0,  1,  2,  9, 10, 11, 18, 19, 20},
+    { 3,  4,  5, 12, 13, 14, 21, 22, 23},
+    { 6,  7,  8, 15, 16, 17, 24, 25, 26},
+    {27, 28, 29, 36, 37, 38, 45, 46, 47},
+    {30, 31, 32, 39, 40, 41, 48, 49, 50},
+    {33, 34, 35, 42, 43, 44, 51, 52, 53},
+    {54, 55, 56, 63, 64, 65, 72, 73, 74},
+    {57, 58, 59, 66, 67, 68, 75, 76, 77},
+    {60, 61, 62, 69, 70, 71, 78, 79, 80},
+};
+
+/* 每个格子所在的行、列、宫 */
+static const unsigned char SD_ROW[81] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8, 8, 8, 8, 8, 8, 8, 8, 8
+};
+static const unsigned char SD_COL[81] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8
+};
+static const unsigned char SD_BOX[81] = {
+    0, 0, 0, 1, 1, 1, 2, 2, 2, 0, 0, 0, 1, 1, 1, 2, 2, 2, 0, 0, 0, 1, 1, 1, 2, 2, 2,
+    3, 3, 3, 4, 4, 4, 5, 5, 5, 3, 3, 3, 4, 4, 4, 5, 5, 5, 3, 3, 3, 4, 4, 4, 5, 5, 5,
+    6, 6, 6, 7, 7, 7, 8, 8, 8, 6, 6, 6, 7, 7, 7, 8, 8, 8, 6, 6, 6, 7, 7, 7, 8, 8, 8
+};
+
+static inline unsigned sd_candidates(const sd_state_t *s, int i)
+{
+    return SD_ALL & ~(s->row[SD_ROW[i]] | s->col[SD_COL[i]] | s->box[SD_BOX[i]]);
+}
+
+/* 单元中已填数字的掩码 */
+static inline unsigned sd_unit_filled(const sd_state_t *s, int u)
+{
+    return u < 9 ? s->row[u] : (u < 18 ? s->col[u - 9] : s->box[u - 18]);
+}
+
+static inline void sd_place(sd_state_t *s, int i, unsigned bit)
+{
+    s->cell[i] = (unsigned char)(__builtin_ctz(bit) + 1);
+    s->row[SD_ROW[i]] |= bit;
+    s->col[SD_COL[i]] |= bit;
+    s->box[SD_BOX[i]] |= bit;
+    s->nFilled++;
+}
+
+/*
+ * 读入一道题：81个字符，'1'..'9'为已知数，'.'或'0'为空格
+ * 格式错误或已知数互相冲突时返回0
+ */
+static inline int sd_parse(const char *text, sd_state_t *s)
+{
+    int i;
+
+    memset(s, 0, sizeof(*s));
+    for (i = 0; i < 81; i++) {
+        char ch = text[i];
+        if (ch == '.' || ch == '0')
+            continue;
+        if (ch < '1' || ch > '9')
+            return 0;
+        if (!(sd_candidates(s, i) & (1u << (ch - '1'))))
+            return 0;
+        sd_place(s, i, 1u << (ch - '1'));
+    }
+    return 1;
+}
+
+static inline void sd_format(const sd_state_t *s, char *text)
+{
+    int i;
+    for (i = 0; i < 81; i++)
+        text[i] = s->cell[i] ? (char)('0' + s->cell[i]) : '.';
+    text[81] = '\0';
+}
+
+/*
+ * 反复使用唯一候选（格子只剩一个候选）和隐性唯一（数字在单元中只剩一个位置）填数，
+ * 直到没有新的推理为止；出现矛盾时返回0
+ */
+static inline int sd_propagate(sd_state_t *s)
+{
+    int changed = 1, i, u, k;
+
+    while (changed && s->nFilled < 81) {
+        changed = 0;
+
+        for (i = 0; i < 81; i++) {
+            unsigned m;
+            if (s->cell[i])
+                continue;
+            m = sd_candidates(s, i);
+            if (!m)
+                return 0;
+            if (!(m & (m - 1))) {
+                sd_place(s, i, m);
+                changed = 1;
+            }
+        }
+        if (changed)
+            continue;
+
+        for (u = 0; u < 27; u++) {
+            unsigned once = 0, twice = 0, single;
+            for (k = 0; k < 9; k++) {
+                unsigned m;
+                i = SD_UNITS[u][k];
+                if (s->cell[i])
+                    continue;
+                m = sd_candidates(s, i);
+                twice |= once & m;
+                once |= m;
+            }
+            if ((once | sd_unit_filled(s, u)) != SD_ALL)
+                return 0;
+
+            single = once & ~twice;
+            while (single) {
+                unsigned bit = single & (0u - single);
+                single ^= bit;
+                for (k = 0; k < 9; k++) {
+                    i = SD_UNITS[u][k];
+                    if (!s->cell[i] && (sd_candidates(s, i) & bit))
+                        break;
+                }
+                /* 同一格子被两个数字同时要求时，前一个填完后这里就找不到了 */
+                if (k == 9)
+                    return 0;
+                sd_place(s, i, bit);
+                changed = 1;
+            }
+        }
+    }
+    return 1;
+}
+
+/* 求第一个解，无解时返回0 */
+static inline int sd_solve(const sd_state_t *init_st, sd_state_t *solution)
+{
+    sd_state_t stack[SD_MAX_NODES], st;
+    int sp = 0;
+
+    sd_push(*init_st);
+    while (sd_stack_not_empty) {
+        int i, best = -1, best_count = 10;
+        unsigned m;
+
+        st = sd_pop();
+        if (!sd_propagate(&st))
+            continue;
+        if (st.nFilled == 81) {
+            *solution = st;
+            return 1;
+        }
+
+        for (i = 0; i < 81 && best_count > 2; i++) {
+            int count;
+            if (st.cell[i])
+                continue;
+            count = __builtin_popcount(sd_candidates(&st, i));
+            if (count < best_count) {
+                best_count = count;
+                best = i;
+            }
+        }
+
+        m = sd_candidates(&st, best);
+        while (m) {
+            unsigned bit = m & (0u - m);
+            sd_state_t child = st;
+            m ^= bit;
+            sd_place(&child, best, bit);
+            sd_push(child);
+        }
+    }
+    return 0;
+}
+
+#endif
@@ -8,6 +8,30 @@
 #include <unordered_set>
 #include <functional>
 
+// 启发式函数类型，用于A*和贪心算法
+enum class HeuristicType {
+    MANHATTAN,        // 曼哈顿距离
+    MISPLACED_TILES,  // 不在位数
+    LINEAR_CONFLICT,  // 曼哈顿距离 + 线性冲突
+    WALKING_DISTANCE  // 行走距离（Walking Distance）
+};
+
+// 开放列表的实现方式，用于A*和贪心算法
+enum class OpenListType {
+    BINARY_HEAP,   // 二叉堆，同优先级的节点出队顺序不确定
+    BUCKET_LIFO,   // 按优先级分桶，桶内后进先出
+    BUCKET_HIGH_G  // 按优先级分桶，桶内优先扩展g值最大（最深）的节点
+};
+
+// 获取启发式函数的名称
+const char* getHeuristicName(HeuristicType type);
+
+// 获取开放列表实现方式的名称
+const char* getOpenListName(OpenListType type);
+
+// 获取空格移动方向（'U'、'D'、'L'、'R'）的中文名称
+const char* getMoveName(char move);
+
 // 八数码问题的状态类
 class EightPuzzleState {
 private:
@@ -55,6 +79,18 @@ public:
     // 计算不在位数（当前状态中有多少数字不在其目标位置上）
     int calculateMisplacedTiles() const;
     
+    // 计算线性冲突启发值：曼哈顿距离加上同行/同列中互相阻挡的数字所需的额外步数
+    int calculateLinearConflict() const;
+    
+    // 计算行走距离启发值：分别查询预计算的行表和列表后求和
+    int calculateWalkingDistance() const;
+    
+    // 按指定类型计算启发式函数值
+    int calculateHeuristic(HeuristicType type) const;
+    
+    // 对按行优先展开的一维棋盘计算启发式函数值，供求解器在紧凑节点上直接调用
+    static int calculateHeuristic(const int tiles[9], HeuristicType type);
+    
     // 设置和获取h值（启发式函数值）
     void setHValue(int h);
     int getHValue() const;
@@ -68,6 +104,9 @@ public:
     // 获取可能的下一步状态
     std::vector<EightPuzzleState*> getNextStates();
     
+    // 按空格的移动方向（'U'、'D'、'L'、'R'）移动一步，移动越界时返回false
+    bool applyMove(char move);
+    
     // 打印当前状态
     void printState() const;
     
@@ -77,6 +116,9 @@ public:
     // 判断两个状态是否相等
     bool equals(const EightPuzzleState& other) const;
 
+    // 将棋盘按行优先展开为一维数组
+    void flatten(int tiles[9]) const;
+
 private:
     // 初始化空格位置
     void findEmptyPosition();
@@ -92,12 +134,84 @@ namespace std {
     };
 }
 
-// 用于A*和贪心算法的状态比较函数
-struct StateComparison {
-    bool operator()(const EightPuzzleState* lhs, const EightPuzzleState* rhs) const {
-        // 对于A*: f = g + h，对于贪心: f = h
-        return lhs->getFValue() > rhs->getFValue();
-    }
+// 紧凑棋盘编码：每格占4位，按行优先存放9个格子
+typedef unsigned long long PackedBoard;
+
+// 搜索节点：由节点池统一分配，通过下标引用父节点
+struct SearchNode {
+    PackedBoard board; // 紧凑棋盘
+    int parent;        // 父节点在节点池中的下标，初始节点为-1
+    short gValue;      // 从初始状态到当前状态的实际步数
+    short hValue;      // 启发值
+    char move;         // 从父节点到当前节点的空格移动方向，初始节点为0
+    char emptyPos;     // 空格位置（0-8）
+    bool closed;       // 是否已经扩展
+    bool stale;        // 是否已被同一状态的更优节点取代
+};
+
+// 节点池：一次搜索中的所有节点存放在一段连续内存中，搜索结束时整体释放
+// 同时维护"状态 -> 最新节点下标"的索引，状态用排列的康托展开编号，无需哈希
+// 节点数组和索引表都由节点池按字节预算分配；开放列表（BFS为队列）的占用由搜索通过setFrontierBytes告知，
+// 一并计入预算，占用内存随时可以精确得到
+class NodePool {
+private:
+    std::vector<SearchNode> nodes; // 所有节点
+    std::vector<int> stateIndex;   // 按康托展开编号索引的节点下标，未访问为-1
+    size_t budget;                 // 内存预算（字节）
+    size_t frontierBytes;          // 开放列表（BFS为队列）当前占用的字节数
+    size_t peakBytes;              // 占用内存的峰值
+
+public:
+    // 预算不足以容纳索引表时，节点池不分配任何内存，所有allocate都会失败
+    explicit NodePool(size_t budgetBytes);
+    
+    // 分配一个新节点并登记为该状态的最新节点，返回其下标；超出内存预算时返回-1
+    // frontierGrowth为随后把该节点加入开放列表时开放列表新增的字节数，一并计入预算
+    int allocate(PackedBoard board, int emptyPos, int parent, char move, int g, int h, size_t frontierGrowth = 0);
+    
+    // 提前释放全部节点和索引表
+    void release();
+    
+    // 查找状态对应的最新节点下标，未访问过返回-1
+    int find(PackedBoard board) const;
+    
+    // 按下标访问节点
+    SearchNode& operator[](int index) { return nodes[index]; }
+    const SearchNode& operator[](int index) const { return nodes[index]; }
+    
+    // 已分配的节点数
+    int size() const { return static_cast<int>(nodes.size()); }
+    
+    // 登记开放列表（BFS为队列）当前占用的字节数，每次入队后调用
+    void setFrontierBytes(size_t bytes);
+    
+    // 当前占用的字节数（节点池、索引表和开放列表）和峰值
+    size_t bytesUsed() const;
+    size_t getPeakBytes() const { return peakBytes; }
+    
+    // 沿父节点下标回溯，得到从初始状态到该节点的移动串
+    std::string buildMoves(int index) const;
+    
+    // 计算状态的康托展开编号（0 ~ 9!-1）
+    static int rank(PackedBoard board);
+};
+
+// 一次搜索的统计信息
+struct SearchStatistics {
+    int nodesExplored;   // 扩展的节点数
+    int nodesGenerated;  // 生成的节点数
+    int initialH;        // 初始状态的启发值
+    int solutionSteps;   // 解的步数，未找到解时为-1
+    size_t peakBytes;    // 节点池、索引表和开放列表（BFS为队列）占用内存的峰值
+    size_t peakOpenSize; // 开放列表（BFS为队列）长度的峰值
+    int nodesReopened;   // 已扩展后又因找到更短路径而重新加入开放列表的节点数
+    int nodesAtSolutionF; // 扩展时f值等于解长度的节点数（A*中即f等于最优代价）
+    bool budgetExceeded; // 节点池是否超出内存预算
+    int fallbackBound;   // A*超出预算后转为IDA*时的起始f阈值，未转换时为-1
+    
+    SearchStatistics()
+        : nodesExplored(0), nodesGenerated(0), initialH(0), solutionSteps(-1), peakBytes(0), peakOpenSize(0),
+          nodesReopened(0), nodesAtSolutionF(0), budgetExceeded(false), fallbackBound(-1) {}
 };
 
 // 八数码问题求解器
@@ -105,6 +219,12 @@ class EightPuzzleSolver {
 private:
     EightPuzzleState* initialState;
     EightPuzzleState* goalState;
+    SearchStatistics lastStatistics; // 最近一次搜索的统计信息
+    bool verbose; // 是否打印每个扩展的状态
+    size_t memoryBudget; // 每次搜索中节点池可用的内存（字节）
+    
+    // A*超出内存预算后的退路：从给定f阈值开始做IDA*，只占用递归路径的内存
+    std::string fallbackIDAStar(PackedBoard board, int emptyPos, HeuristicType heuristic, int bound);
     
 public:
     // 构造函数
@@ -113,17 +233,40 @@ public:
     // 析构函数
     ~EightPuzzleSolver();
     
+    // 以下求解函数返回空格的移动串（如"ULDR"），
+    // 是否找到解以getLastStatistics().solutionSteps是否为-1为准
+    
     // 广度优先搜索
-    std::vector<EightPuzzleState*> solveBFS();
+    std::string solveBFS();
+    
+    // A*搜索算法，默认使用曼哈顿距离作为启发式函数，f值相同时优先扩展g值大的节点
+    std::string solveAStar(HeuristicType heuristic = HeuristicType::MANHATTAN,
+                           OpenListType openListType = OpenListType::BUCKET_HIGH_G);
+    
+    // 贪心最佳优先搜索，默认使用曼哈顿距离作为启发式函数，h值相同时后入队的节点先扩展
+    // （贪心算法中深g优先会让解明显变长，因此默认使用LIFO）
+    std::string solveGreedy(HeuristicType heuristic = HeuristicType::MANHATTAN,
+                            OpenListType openListType = OpenListType::BUCKET_LIFO);
+    
+    // 将移动串从初始状态回放为状态序列，遇到非法移动时停止
+    static std::vector<EightPuzzleState> replaySolution(const EightPuzzleState& initial, const std::string& moves);
+    
+    // 默认的内存预算
+    static const size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+    
+    // 设置每次搜索中节点池可用的内存（字节）
+    // 超出预算时BFS和贪心算法报告失败，A*转为IDA*继续求解
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
     
-    // A*搜索算法，使用曼哈顿距离作为启发式函数
-    std::vector<EightPuzzleState*> solveAStar();
+    // 获取最近一次搜索的统计信息
+    const SearchStatistics& getLastStatistics() const;
     
-    // 贪心最佳优先搜索，使用曼哈顿距离作为启发式函数
-    std::vector<EightPuzzleState*> solveGreedy();
+    // 设置是否打印搜索过程和失败提示（编译时定义EIGHT_PUZZLE_NO_TRACE则始终不打印搜索过程）
+    void setVerbose(bool v);
     
     // 打印解决方案
-    void printSolution(const std::vector<EightPuzzleState*>& solution);
+    void printSolution(const std::string& moves);
     
     // 检查问题是否有解
     bool isSolvable(const EightPuzzleState& initial) const;
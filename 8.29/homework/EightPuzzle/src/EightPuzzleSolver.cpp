@@ -1,16 +1,421 @@
 #include "EightPuzzle.h"
 #include <iostream>
 #include <queue>
-#include <stack>
-#include <unordered_set>
-#include <unordered_map>
 #include <algorithm>
+#include <climits>
 
 // 添加彩色显示状态的前向声明（函数在main.cpp中定义）
 void displayColorState(const EightPuzzleState& state);
 
+namespace {
+
+// 9! = 362880，八数码全部排列的个数
+const int PERMUTATION_COUNT = 362880;
+
+// 目标状态 1 2 3 / 4 5 6 / 7 8 0 的紧凑编码
+const PackedBoard GOAL_BOARD = 0x087654321ULL;
+
+// 空格可能的移动方向：上、下、左、右
+const char MOVES[4] = {'U', 'D', 'L', 'R'};
+const int MOVE_DR[4] = {-1, 1, 0, 0};
+const int MOVE_DC[4] = {0, 0, -1, 1};
+
+// 取出紧凑棋盘某一格的数字
+inline int tileAt(PackedBoard board, int pos) {
+    return static_cast<int>((board >> (pos * 4)) & 0xF);
+}
+
+// 将状态对象编码为紧凑棋盘
+PackedBoard packBoard(const EightPuzzleState& state, int& emptyPos) {
+    int tiles[9];
+    state.flatten(tiles);
+    PackedBoard board = 0;
+    for (int pos = 0; pos < 9; ++pos) {
+        board |= static_cast<PackedBoard>(tiles[pos]) << (pos * 4);
+        if (tiles[pos] == 0) {
+            emptyPos = pos;
+        }
+    }
+    return board;
+}
+
+// 将紧凑棋盘展开为一维数组
+void unpackTiles(PackedBoard board, int tiles[9]) {
+    for (int pos = 0; pos < 9; ++pos) {
+        tiles[pos] = tileAt(board, pos);
+    }
+}
+
+// 计算空格按方向dir移动后的新空格位置，越界返回-1
+inline int movedEmptyPos(int emptyPos, int dir) {
+    int newRow = emptyPos / 3 + MOVE_DR[dir];
+    int newCol = emptyPos % 3 + MOVE_DC[dir];
+    if (newRow < 0 || newRow >= 3 || newCol < 0 || newCol >= 3) {
+        return -1;
+    }
+    return newRow * 3 + newCol;
+}
+
+// 空格从emptyPos移到newEmptyPos后的紧凑棋盘
+inline PackedBoard slideTile(PackedBoard board, int emptyPos, int newEmptyPos) {
+    PackedBoard tile = (board >> (newEmptyPos * 4)) & 0xF;
+    board &= ~(static_cast<PackedBoard>(0xF) << (newEmptyPos * 4));
+    return board | (tile << (emptyPos * 4));
+}
+
+// 计算紧凑棋盘的启发值
+inline int evaluateBoard(PackedBoard board, HeuristicType heuristic) {
+    int tiles[9];
+    unpackTiles(board, tiles);
+    return EightPuzzleState::calculateHeuristic(tiles, heuristic);
+}
+
+#ifndef EIGHT_PUZZLE_NO_TRACE
+// 将紧凑棋盘还原为状态对象，仅用于打印搜索过程
+EightPuzzleState unpackState(PackedBoard board) {
+    std::vector<std::vector<int>> b(3, std::vector<int>(3));
+    for (int pos = 0; pos < 9; ++pos) {
+        b[pos / 3][pos % 3] = tileAt(board, pos);
+    }
+    return EightPuzzleState(b);
+}
+
+// 打印正在扩展的节点
+// 编译时定义EIGHT_PUZZLE_NO_TRACE可以整体去掉这部分输出，基准测试使用这种方式编译
+void traceNode(const SearchNode& node, int nodesExplored, bool showCost) {
+    if (showCost) {
+        std::cout << "当前状态 (g=" << node.gValue << ", h=" << node.hValue
+                  << ", f=" << node.gValue + node.hValue << ")：" << std::endl;
+    } else {
+        std::cout << "当前状态：" << std::endl;
+    }
+    displayColorState(unpackState(node.board)); // 使用彩色显示替代printState
+    std::cout << "动作：" << getMoveName(node.move) << std::endl;
+    std::cout << "已探索节点数：" << nodesExplored << std::endl;
+    std::cout << "------------------------" << std::endl;
+}
+#endif
+
+// 开放列表中的条目：按优先级从小到大出队
+struct OpenEntry {
+    int priority; // A*为f值，贪心为h值
+    int index;    // 节点在节点池中的下标
+};
+
+struct OpenEntryComparison {
+    bool operator()(const OpenEntry& lhs, const OpenEntry& rhs) const {
+        return lhs.priority > rhs.priority;
+    }
+};
+
+// 开放列表：二叉堆，或按优先级分桶
+// 八数码的f值和h值都是很小的整数，分桶后出队只需移动最小优先级游标，
+// 桶内再按g值分层，可以让f值相同的节点中离目标更近（g更大）的先扩展
+// 各数组都按固定规则显式扩容，扩容前就能算出一次入队会新增多少字节；
+// bytesUsed()是包括作废条目在内的实际占用
+class OpenList {
+private:
+    OpenListType type;
+    std::vector<OpenEntry> heap; // 用push_heap/pop_heap维护的小顶堆
+    std::vector<std::vector<std::vector<int>>> buckets; // buckets[优先级][g值]，LIFO模式只用g=0一层
+    std::vector<int> topG;  // 每个优先级桶中非空的最大g层，空桶为-1
+    int minPriority;        // 可能非空的最小优先级
+    size_t count;
+    size_t bytes;           // 所有数组的容量占用的字节数
+
+    // 数组要容纳needed个元素时的新容量：不够时倍增
+    template <class T>
+    static size_t grownCapacity(const std::vector<T>& v, size_t needed) {
+        return needed <= v.capacity() ? v.capacity() : std::max(needed, std::max<size_t>(v.capacity() * 2, 8));
+    }
+
+    template <class T>
+    static size_t growthBytes(const std::vector<T>& v, size_t needed) {
+        return (grownCapacity(v, needed) - v.capacity()) * sizeof(T);
+    }
+
+    // 扩容到能容纳needed个元素，并把新增的容量计入bytes
+    template <class T>
+    void reserveFor(std::vector<T>& v, size_t needed) {
+        bytes += growthBytes(v, needed);
+        v.reserve(grownCapacity(v, needed));
+    }
+
+public:
+    explicit OpenList(OpenListType t) : type(t), minPriority(0), count(0), bytes(0) {}
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    size_t bytesUsed() const { return bytes; }
+
+    // push(priority, g, ...)会新增的字节数，分配节点前用来检查预算
+    size_t pushGrowth(int priority, int g) const {
+        if (type == OpenListType::BINARY_HEAP) {
+            return growthBytes(heap, heap.size() + 1);
+        }
+        int layer = (type == OpenListType::BUCKET_HIGH_G) ? g : 0;
+        if (priority >= static_cast<int>(buckets.size())) {
+            // 新的优先级桶：外层数组和topG扩容，新桶的g层数组和第一个元素的空间
+            size_t layers = std::max(layer + 1, 8) * sizeof(std::vector<int>);
+            return growthBytes(buckets, priority + 1) + growthBytes(topG, priority + 1) + layers + 8 * sizeof(int);
+        }
+        const std::vector<std::vector<int>>& bucket = buckets[priority];
+        if (layer >= static_cast<int>(bucket.size())) {
+            return growthBytes(bucket, layer + 1) + 8 * sizeof(int);
+        }
+        return growthBytes(bucket[layer], bucket[layer].size() + 1);
+    }
+
+    void push(int priority, int g, int index) {
+        count++;
+        if (type == OpenListType::BINARY_HEAP) {
+            OpenEntry entry = {priority, index};
+            reserveFor(heap, heap.size() + 1);
+            heap.push_back(entry);
+            std::push_heap(heap.begin(), heap.end(), OpenEntryComparison());
+            return;
+        }
+
+        int layer = (type == OpenListType::BUCKET_HIGH_G) ? g : 0;
+        if (priority >= static_cast<int>(buckets.size())) {
+            reserveFor(buckets, priority + 1);
+            reserveFor(topG, priority + 1);
+            buckets.resize(priority + 1);
+            topG.resize(priority + 1, -1);
+        }
+        std::vector<std::vector<int>>& bucket = buckets[priority];
+        if (layer >= static_cast<int>(bucket.size())) {
+            reserveFor(bucket, layer + 1);
+            bucket.resize(layer + 1);
+        }
+        reserveFor(bucket[layer], bucket[layer].size() + 1);
+        bucket[layer].push_back(index);
+        topG[priority] = std::max(topG[priority], layer);
+        minPriority = std::min(minPriority, priority);
+    }
+
+    // 取出优先级最小的节点下标，调用前需保证非空
+    int pop() {
+        count--;
+        if (type == OpenListType::BINARY_HEAP) {
+            std::pop_heap(heap.begin(), heap.end(), OpenEntryComparison());
+            int index = heap.back().index;
+            heap.pop_back();
+            return index;
+        }
+
+        while (topG[minPriority] < 0) {
+            minPriority++;
+        }
+        std::vector<std::vector<int>>& bucket = buckets[minPriority];
+        int& layer = topG[minPriority];
+        int index = bucket[layer].back();
+        bucket[layer].pop_back();
+        while (layer >= 0 && bucket[layer].empty()) {
+            layer--;
+        }
+        return index;
+    }
+};
+
+// BFS的队列：容量按倍增扩展的环形缓冲区，占用的字节数即容量
+class FifoQueue {
+private:
+    std::vector<int> buffer;
+    size_t head;
+    size_t count;
+
+public:
+    FifoQueue() : head(0), count(0) {}
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    size_t bytesUsed() const { return buffer.capacity() * sizeof(int); }
+
+    // 缓冲区满时倍增
+    size_t grownSize() const {
+        return count < buffer.size() ? buffer.size() : std::max<size_t>(buffer.size() * 2, 1024);
+    }
+
+    // push会新增的字节数，分配节点前用来检查预算
+    size_t pushGrowth() const {
+        return (grownSize() - buffer.size()) * sizeof(int);
+    }
+
+    void push(int index) {
+        if (count == buffer.size()) {
+            // 扩容时把环形缓冲区中的元素按顺序搬到新数组开头
+            std::vector<int> grown(grownSize());
+            for (size_t i = 0; i < count; ++i) {
+                grown[i] = buffer[(head + i) % buffer.size()];
+            }
+            buffer.swap(grown);
+            head = 0;
+        }
+        buffer[(head + count) % buffer.size()] = index;
+        count++;
+    }
+
+    // 取出队首，调用前需保证非空
+    int pop() {
+        int index = buffer[head];
+        head = (head + 1) % buffer.size();
+        count--;
+        return index;
+    }
+};
+
+// 打印搜索失败的原因
+void reportFailure(const SearchStatistics& stats, size_t budget, bool verbose) {
+    if (!verbose) {
+        return;
+    }
+    if (stats.budgetExceeded) {
+        std::cout << "超出内存预算（" << budget / 1024 << " KB），未找到解决方案！" << std::endl;
+    } else {
+        std::cout << "搜索完所有可达状态，未找到解决方案！" << std::endl;
+    }
+}
+
+// IDA*的一轮深度受限搜索：f值超过阈值的分支被剪掉，并记录其中最小的f值作为下一轮阈值
+struct IDAStarSearch {
+    HeuristicType heuristic;
+    std::string path;   // 当前路径上的移动串
+    int nodesExplored;
+    int nextBound;
+
+    bool search(PackedBoard board, int emptyPos, int g, int bound, int lastDir) {
+        int f = g + evaluateBoard(board, heuristic);
+        if (f > bound) {
+            nextBound = std::min(nextBound, f);
+            return false;
+        }
+        nodesExplored++;
+        if (board == GOAL_BOARD) {
+            return true;
+        }
+
+        for (int dir = 0; dir < 4; ++dir) {
+            // 不走回头路：上下互逆、左右互逆
+            if (lastDir >= 0 && dir == (lastDir ^ 1)) {
+                continue;
+            }
+            int nextEmpty = movedEmptyPos(emptyPos, dir);
+            if (nextEmpty < 0) {
+                continue;
+            }
+            path.push_back(MOVES[dir]);
+            if (search(slideTile(board, emptyPos, nextEmpty), nextEmpty, g + 1, bound, dir)) {
+                return true;
+            }
+            path.pop_back();
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+// 节点池构造函数
+NodePool::NodePool(size_t budgetBytes) : budget(budgetBytes), frontierBytes(0), peakBytes(0) {
+    if (budget >= PERMUTATION_COUNT * sizeof(int)) {
+        stateIndex.assign(PERMUTATION_COUNT, -1);
+    }
+    peakBytes = bytesUsed();
+}
+
+// 分配一个新节点并登记为该状态的最新节点
+// 节点数组自行按倍增扩容，但不超过预算中除去索引表、开放列表及其即将新增部分后剩余部分能容纳的节点数
+int NodePool::allocate(PackedBoard board, int emptyPos, int parent, char move, int g, int h, size_t frontierGrowth) {
+    if (stateIndex.empty()) {
+        return -1;
+    }
+    size_t otherBytes = stateIndex.capacity() * sizeof(int) + frontierBytes + frontierGrowth;
+    size_t maxNodes = otherBytes < budget ? (budget - otherBytes) / sizeof(SearchNode) : 0;
+    size_t capacity = nodes.capacity();
+    if (nodes.size() == capacity) {
+        capacity = std::min(std::max<size_t>(capacity * 2, 1024), maxNodes);
+    }
+    if (nodes.size() >= capacity || capacity > maxNodes) {
+        return -1;
+    }
+    if (capacity != nodes.capacity()) {
+        nodes.reserve(capacity);
+    }
+    
+    SearchNode node;
+    node.board = board;
+    node.parent = parent;
+    node.gValue = static_cast<short>(g);
+    node.hValue = static_cast<short>(h);
+    node.move = move;
+    node.emptyPos = static_cast<char>(emptyPos);
+    node.closed = false;
+    node.stale = false;
+    
+    int index = static_cast<int>(nodes.size());
+    nodes.push_back(node);
+    stateIndex[rank(board)] = index;
+    
+    peakBytes = std::max(peakBytes, bytesUsed());
+    return index;
+}
+
+// 提前释放全部节点和索引表
+void NodePool::release() {
+    std::vector<SearchNode>().swap(nodes);
+    std::vector<int>().swap(stateIndex);
+}
+
+// 查找状态对应的最新节点下标
+int NodePool::find(PackedBoard board) const {
+    return stateIndex.empty() ? -1 : stateIndex[rank(board)];
+}
+
+// 登记开放列表当前占用的字节数，并更新峰值
+void NodePool::setFrontierBytes(size_t bytes) {
+    frontierBytes = bytes;
+    peakBytes = std::max(peakBytes, bytesUsed());
+}
+
+// 当前占用的字节数
+size_t NodePool::bytesUsed() const {
+    return nodes.capacity() * sizeof(SearchNode) + stateIndex.capacity() * sizeof(int) + frontierBytes;
+}
+
+// 沿父节点下标回溯，得到移动串
+std::string NodePool::buildMoves(int index) const {
+    std::string moves;
+    while (index >= 0 && nodes[index].parent >= 0) {
+        moves.push_back(nodes[index].move);
+        index = nodes[index].parent;
+    }
+    // 反转路径，从初始状态到目标状态
+    std::reverse(moves.begin(), moves.end());
+    return moves;
+}
+
+// 计算康托展开编号：依次统计每一位之后比它小且尚未出现的数字个数
+int NodePool::rank(PackedBoard board) {
+    int result = 0;
+    int used = 0;
+    for (int pos = 0; pos < 9; ++pos) {
+        int value = tileAt(board, pos);
+        int smaller = 0;
+        for (int v = 0; v < value; ++v) {
+            if (!(used & (1 << v))) {
+                smaller++;
+            }
+        }
+        used |= 1 << value;
+        result = result * (9 - pos) + smaller;
+    }
+    return result;
+}
+
 // 构造函数
-EightPuzzleSolver::EightPuzzleSolver(const std::vector<std::vector<int>>& initial, const std::vector<std::vector<int>>& goal) {
+EightPuzzleSolver::EightPuzzleSolver(const std::vector<std::vector<int>>& initial, const std::vector<std::vector<int>>& goal)
+    : verbose(true), memoryBudget(DEFAULT_MEMORY_BUDGET) {
     initialState = new EightPuzzleState(initial);
     goalState = new EightPuzzleState(goal);
 }
@@ -22,318 +427,395 @@ EightPuzzleSolver::~EightPuzzleSolver() {
 }
 
 // 广度优先搜索
-std::vector<EightPuzzleState*> EightPuzzleSolver::solveBFS() {
-    std::vector<EightPuzzleState*> solution;
+std::string EightPuzzleSolver::solveBFS() {
+    lastStatistics = SearchStatistics();
     
     // 检查问题是否有解
     if (!isSolvable(*initialState)) {
-        std::cout << "此八数码问题无解！" << std::endl;
-        return solution;
+        if (verbose) {
+            std::cout << "此八数码问题无解！" << std::endl;
+        }
+        return "";
     }
     
-    // 使用队列进行BFS
-    std::queue<EightPuzzleState*> queue;
-    std::unordered_set<std::string> visited;
+    // 所有节点由节点池管理，队列中只保存下标
+    NodePool pool(memoryBudget);
+    FifoQueue queue;
     
     // 将初始状态加入队列
-    queue.push(initialState);
-    visited.insert(initialState->getHashCode());
+    int emptyPos = 8;
+    PackedBoard initialBoard = packBoard(*initialState, emptyPos);
+    int initialIndex = pool.allocate(initialBoard, emptyPos, -1, 0, 0, 0, queue.pushGrowth());
+    if (initialIndex >= 0) {
+        queue.push(initialIndex);
+        pool.setFrontierBytes(queue.bytesUsed());
+    } else {
+        lastStatistics.budgetExceeded = true;
+    }
     
     // 记录搜索的节点数
     int nodesExplored = 0;
     
-    // 开始BFS
-    while (!queue.empty() && nodesExplored < 100000) { // 添加节点探索上限
-        EightPuzzleState* current = queue.front();
-        queue.pop();
+    // 开始BFS，直到队列为空或节点池超出内存预算
+    while (!queue.empty() && !lastStatistics.budgetExceeded) {
+        int current = queue.pop();
         nodesExplored++;
         
         // 打印当前状态，使用彩色显示
-        std::cout << "当前状态：" << std::endl;
-        displayColorState(*current); // 使用彩色显示替代printState
-        std::cout << "动作：" << current->getAction() << std::endl;
-        std::cout << "已探索节点数：" << nodesExplored << std::endl;
-        std::cout << "------------------------" << std::endl;
+#ifndef EIGHT_PUZZLE_NO_TRACE
+        if (verbose) {
+            traceNode(pool[current], nodesExplored, false);
+        }
+#endif
         
         // 判断是否达到目标状态
-        if (current->isGoal()) {
-            // 构建解决方案路径
-            EightPuzzleState* state = current;
-            while (state != nullptr) {
-                solution.push_back(state);
-                state = state->getParent();
-            }
-            // 反转路径，从初始状态到目标状态
-            std::reverse(solution.begin(), solution.end());
-            return solution;
+        if (pool[current].board == GOAL_BOARD) {
+            std::string moves = pool.buildMoves(current);
+            lastStatistics.nodesExplored = nodesExplored;
+            lastStatistics.solutionSteps = static_cast<int>(moves.size());
+            lastStatistics.peakBytes = pool.getPeakBytes();
+            return moves;
         }
         
-        // 获取下一步可能的状态
-        std::vector<EightPuzzleState*> nextStates = current->getNextStates();
-        for (EightPuzzleState* next : nextStates) {
-            if (visited.find(next->getHashCode()) == visited.end()) {
+        // 生成下一步可能的状态，已访问过的状态直接跳过
+        for (int dir = 0; dir < 4; ++dir) {
+            const SearchNode& node = pool[current];
+            int nextEmpty = movedEmptyPos(node.emptyPos, dir);
+            if (nextEmpty < 0) {
+                continue;
+            }
+            PackedBoard nextBoard = slideTile(node.board, node.emptyPos, nextEmpty);
+            lastStatistics.nodesGenerated++;
+            if (pool.find(nextBoard) < 0) {
+                int next = pool.allocate(nextBoard, nextEmpty, current, MOVES[dir], node.gValue + 1, 0, queue.pushGrowth());
+                if (next < 0) {
+                    lastStatistics.budgetExceeded = true;
+                    break;
+                }
                 queue.push(next);
-                visited.insert(next->getHashCode());
-            } else {
-                // 如果状态已经访问过，释放内存
-                delete next;
+                pool.setFrontierBytes(queue.bytesUsed());
             }
         }
+        lastStatistics.peakOpenSize = std::max(lastStatistics.peakOpenSize, queue.size());
     }
     
-    std::cout << "搜索超出限制，未找到解决方案！" << std::endl;
-    return solution; // 如果找不到解决方案，返回空向量
+    lastStatistics.nodesExplored = nodesExplored;
+    lastStatistics.peakBytes = pool.getPeakBytes();
+    reportFailure(lastStatistics, memoryBudget, verbose);
+    return ""; // 如果找不到解决方案，返回空串
 }
 
-// A*搜索算法，使用曼哈顿距离作为启发式函数
-std::vector<EightPuzzleState*> EightPuzzleSolver::solveAStar() {
-    std::vector<EightPuzzleState*> solution;
+// A*搜索算法，启发式函数由参数指定
+std::string EightPuzzleSolver::solveAStar(HeuristicType heuristic, OpenListType openListType) {
+    lastStatistics = SearchStatistics();
     
     // 检查问题是否有解
     if (!isSolvable(*initialState)) {
-        std::cout << "此八数码问题无解！" << std::endl;
-        return solution;
+        if (verbose) {
+            std::cout << "此八数码问题无解！" << std::endl;
+        }
+        return "";
     }
     
-    // 使用优先队列实现A*搜索，优先队列按F值(G+H)排序
-    std::priority_queue<EightPuzzleState*, std::vector<EightPuzzleState*>, StateComparison> openList;
-    std::unordered_set<std::string> closedList; // 记录已访问的状态
-    std::unordered_map<std::string, EightPuzzleState*> allStates; // 记录所有创建的状态，用于内存管理
+    // 开放列表按F值(G+H)排序；闭集和"已有更优节点"用节点上的标记表示
+    NodePool pool(memoryBudget);
+    OpenList openList(openListType);
+    std::vector<int> expandedPerF; // 按f值统计的扩展节点数
     
     // 初始状态的g值为0，计算h值
-    initialState->setGValue(0);
-    initialState->setHValue(initialState->calculateManhattanDistance());
+    int emptyPos = 8;
+    PackedBoard initialBoard = packBoard(*initialState, emptyPos);
+    int initialH = evaluateBoard(initialBoard, heuristic);
+    lastStatistics.initialH = initialH;
     
     // 将初始状态加入开放列表
-    openList.push(initialState);
-    allStates[initialState->getHashCode()] = initialState;
+    int initialIndex = pool.allocate(initialBoard, emptyPos, -1, 0, 0, initialH, openList.pushGrowth(initialH, 0));
+    if (initialIndex >= 0) {
+        openList.push(initialH, 0, initialIndex);
+        pool.setFrontierBytes(openList.bytesUsed());
+    } else {
+        lastStatistics.budgetExceeded = true;
+        lastStatistics.fallbackBound = initialH;
+    }
     
     // 记录搜索的节点数
     int nodesExplored = 0;
     
-    // 开始A*搜索
-    while (!openList.empty() && nodesExplored < 100000) { // 添加节点探索上限
+    // 开始A*搜索，直到开放列表为空或节点池超出内存预算
+    while (!openList.empty() && !lastStatistics.budgetExceeded) {
         // 获取F值最小的状态
-        EightPuzzleState* current = openList.top();
-        openList.pop();
+        int current = openList.pop();
         
-        // 如果当前状态已经在闭集中，继续下一个
-        if (closedList.find(current->getHashCode()) != closedList.end()) {
+        // 已扩展或已被更优路径取代的节点直接跳过
+        if (pool[current].closed || pool[current].stale) {
             continue;
         }
         
         // 将当前状态加入闭集
-        closedList.insert(current->getHashCode());
+        pool[current].closed = true;
         nodesExplored++;
         
+        int currentF = pool[current].gValue + pool[current].hValue;
+        if (currentF >= static_cast<int>(expandedPerF.size())) {
+            expandedPerF.resize(currentF + 1, 0);
+        }
+        expandedPerF[currentF]++;
+        
         // 打印当前状态，使用彩色显示
-        std::cout << "当前状态 (g=" << current->getGValue() << ", h=" << current->getHValue() 
-                  << ", f=" << current->getFValue() << ")：" << std::endl;
-        displayColorState(*current); // 使用彩色显示替代printState
-        std::cout << "动作：" << current->getAction() << std::endl;
-        std::cout << "已探索节点数：" << nodesExplored << std::endl;
-        std::cout << "------------------------" << std::endl;
+#ifndef EIGHT_PUZZLE_NO_TRACE
+        if (verbose) {
+            traceNode(pool[current], nodesExplored, true);
+        }
+#endif
         
         // 判断是否达到目标状态
-        if (current->isGoal()) {
-            // 构建解决方案路径
-            EightPuzzleState* state = current;
-            while (state != nullptr) {
-                solution.push_back(state);
-                state = state->getParent();
-            }
-            // 反转路径，从初始状态到目标状态
-            std::reverse(solution.begin(), solution.end());
-            
-            // 释放内存（除了解决方案路径中的状态）
-            for (auto& pair : allStates) {
-                if (std::find(solution.begin(), solution.end(), pair.second) == solution.end()) {
-                    delete pair.second;
-                }
-            }
-            
-            return solution;
+        if (pool[current].board == GOAL_BOARD) {
+            std::string moves = pool.buildMoves(current);
+            lastStatistics.nodesExplored = nodesExplored;
+            lastStatistics.solutionSteps = static_cast<int>(moves.size());
+            lastStatistics.nodesAtSolutionF = expandedPerF[currentF];
+            lastStatistics.peakBytes = pool.getPeakBytes();
+            return moves;
         }
         
-        // 获取下一步可能的状态
-        std::vector<EightPuzzleState*> nextStates = current->getNextStates();
-        for (EightPuzzleState* next : nextStates) {
-            std::string hashCode = next->getHashCode();
-            
-            // 如果该状态已经在闭集中，则释放内存并继续
-            if (closedList.find(hashCode) != closedList.end()) {
-                delete next;
+        // 生成下一步可能的状态
+        for (int dir = 0; dir < 4; ++dir) {
+            const SearchNode& node = pool[current];
+            int nextEmpty = movedEmptyPos(node.emptyPos, dir);
+            if (nextEmpty < 0) {
                 continue;
             }
+            PackedBoard nextBoard = slideTile(node.board, node.emptyPos, nextEmpty);
+            int nextG = node.gValue + 1;
+            lastStatistics.nodesGenerated++;
             
-            // 计算启发式函数值
-            next->setHValue(next->calculateManhattanDistance());
-            
-            // 检查是否已经在开放列表中有相同的状态
-            if (allStates.find(hashCode) != allStates.end()) {
-                // 比较G值，如果新的路径更短，则更新
-                EightPuzzleState* existingState = allStates[hashCode];
-                if (next->getGValue() < existingState->getGValue()) {
-                    // 更新现有状态的G值和父状态
-                    existingState->setGValue(next->getGValue());
-                    existingState->setParent(current);
-                    existingState->setAction(next->getAction());
+            int existing = pool.find(nextBoard);
+            int nextH;
+            if (existing >= 0) {
+                // 新路径不比已有路径短，则跳过
+                if (nextG >= pool[existing].gValue) {
+                    continue;
                 }
-                // 释放新创建的状态，因为我们已经有相同的状态
-                delete next;
+                // 新路径更短：旧节点作废，复用已算出的启发值
+                // 启发函数不一致时已扩展的状态也可能出现更短路径，此时需要重新打开
+                if (pool[existing].closed) {
+                    lastStatistics.nodesReopened++;
+                }
+                pool[existing].stale = true;
+                nextH = pool[existing].hValue;
             } else {
-                // 加入新状态到开放列表和所有状态映射
-                openList.push(next);
-                allStates[hashCode] = next;
+                // 计算启发式函数值
+                nextH = evaluateBoard(nextBoard, heuristic);
+            }
+            
+            // 注意：allocate可能使节点池扩容，之后不能再使用node引用
+            int next = pool.allocate(nextBoard, nextEmpty, current, MOVES[dir], nextG, nextH,
+                                     openList.pushGrowth(nextG + nextH, nextG));
+            if (next < 0) {
+                // 当前节点的f值是开放列表中的最小值，不会超过最优解长度，IDA*从这里继续
+                lastStatistics.budgetExceeded = true;
+                lastStatistics.fallbackBound = currentF;
+                break;
             }
+            openList.push(nextG + nextH, nextG, next);
+            pool.setFrontierBytes(openList.bytesUsed());
         }
+        lastStatistics.peakOpenSize = std::max(lastStatistics.peakOpenSize, openList.size());
     }
     
-    std::cout << "搜索超出限制，未找到解决方案！" << std::endl;
+    lastStatistics.nodesExplored = nodesExplored;
+    lastStatistics.peakBytes = pool.getPeakBytes();
     
-    // 释放所有创建的状态
-    for (auto& pair : allStates) {
-        delete pair.second;
+    // 超出内存预算：释放节点池，改用只占用路径内存的IDA*
+    if (lastStatistics.budgetExceeded) {
+        pool.release();
+        return fallbackIDAStar(initialBoard, emptyPos, heuristic, lastStatistics.fallbackBound);
     }
     
-    return solution; // 如果找不到解决方案，返回空向量
+    reportFailure(lastStatistics, memoryBudget, verbose);
+    return ""; // 如果找不到解决方案，返回空串
 }
 
-// 贪心最佳优先搜索，使用曼哈顿距离作为启发式函数
-std::vector<EightPuzzleState*> EightPuzzleSolver::solveGreedy() {
-    std::vector<EightPuzzleState*> solution;
+// 贪心最佳优先搜索，启发式函数由参数指定
+std::string EightPuzzleSolver::solveGreedy(HeuristicType heuristic, OpenListType openListType) {
+    lastStatistics = SearchStatistics();
     
     // 检查问题是否有解
     if (!isSolvable(*initialState)) {
-        std::cout << "此八数码问题无解！" << std::endl;
-        return solution;
+        if (verbose) {
+            std::cout << "此八数码问题无解！" << std::endl;
+        }
+        return "";
     }
     
-    // 使用优先队列实现贪心最佳优先搜索，优先队列仅按H值排序
-    std::priority_queue<EightPuzzleState*, std::vector<EightPuzzleState*>, StateComparison> openList;
-    std::unordered_set<std::string> closedList; // 记录已访问的状态
-    std::unordered_map<std::string, EightPuzzleState*> allStates; // 记录所有创建的状态，用于内存管理
+    // 开放列表仅按H值排序；节点仍记录真实的g值，用于统计解的步数
+    NodePool pool(memoryBudget);
+    OpenList openList(openListType);
+    std::vector<int> expandedPerF; // 按f值统计的扩展节点数
     
-    // 初始状态的g值为0，计算h值
-    initialState->setGValue(0);
-    // 在贪心算法中，我们只关心h值，但是我们仍然使用F值进行排序
-    // 为了贪心算法，我们将h值设置为曼哈顿距离，g值设为0（在状态比较时忽略g值）
-    initialState->setHValue(initialState->calculateManhattanDistance());
+    int emptyPos = 8;
+    PackedBoard initialBoard = packBoard(*initialState, emptyPos);
+    int initialH = evaluateBoard(initialBoard, heuristic);
+    lastStatistics.initialH = initialH;
     
     // 将初始状态加入开放列表
-    openList.push(initialState);
-    allStates[initialState->getHashCode()] = initialState;
+    int initialIndex = pool.allocate(initialBoard, emptyPos, -1, 0, 0, initialH, openList.pushGrowth(initialH, 0));
+    if (initialIndex >= 0) {
+        openList.push(initialH, 0, initialIndex);
+        pool.setFrontierBytes(openList.bytesUsed());
+    } else {
+        lastStatistics.budgetExceeded = true;
+    }
     
     // 记录搜索的节点数
     int nodesExplored = 0;
     
-    // 开始贪心搜索
-    while (!openList.empty() && nodesExplored < 100000) { // 添加节点探索上限
+    // 开始贪心搜索，直到开放列表为空或节点池超出内存预算
+    while (!openList.empty() && !lastStatistics.budgetExceeded) {
         // 获取H值最小的状态
-        EightPuzzleState* current = openList.top();
-        openList.pop();
-        
-        // 如果当前状态已经在闭集中，继续下一个
-        if (closedList.find(current->getHashCode()) != closedList.end()) {
-            continue;
-        }
+        int current = openList.pop();
         
         // 将当前状态加入闭集
-        closedList.insert(current->getHashCode());
+        pool[current].closed = true;
         nodesExplored++;
         
+        int currentF = pool[current].gValue + pool[current].hValue;
+        if (currentF >= static_cast<int>(expandedPerF.size())) {
+            expandedPerF.resize(currentF + 1, 0);
+        }
+        expandedPerF[currentF]++;
+        
         // 打印当前状态，使用彩色显示
-        std::cout << "当前状态 (g=" << current->getGValue() << ", h=" << current->getHValue() 
-                  << ", f=" << current->getFValue() << ")：" << std::endl;
-        displayColorState(*current); // 使用彩色显示替代printState
-        std::cout << "动作：" << current->getAction() << std::endl;
-        std::cout << "已探索节点数：" << nodesExplored << std::endl;
-        std::cout << "------------------------" << std::endl;
+#ifndef EIGHT_PUZZLE_NO_TRACE
+        if (verbose) {
+            traceNode(pool[current], nodesExplored, true);
+        }
+#endif
         
         // 判断是否达到目标状态
-        if (current->isGoal()) {
-            // 构建解决方案路径
-            EightPuzzleState* state = current;
-            while (state != nullptr) {
-                solution.push_back(state);
-                state = state->getParent();
-            }
-            // 反转路径，从初始状态到目标状态
-            std::reverse(solution.begin(), solution.end());
-            
-            // 释放内存（除了解决方案路径中的状态）
-            for (auto& pair : allStates) {
-                if (std::find(solution.begin(), solution.end(), pair.second) == solution.end()) {
-                    delete pair.second;
-                }
-            }
-            
-            return solution;
+        if (pool[current].board == GOAL_BOARD) {
+            std::string moves = pool.buildMoves(current);
+            lastStatistics.nodesExplored = nodesExplored;
+            lastStatistics.solutionSteps = static_cast<int>(moves.size());
+            lastStatistics.nodesAtSolutionF = expandedPerF[currentF];
+            lastStatistics.peakBytes = pool.getPeakBytes();
+            return moves;
         }
         
-        // 获取下一步可能的状态
-        std::vector<EightPuzzleState*> nextStates = current->getNextStates();
-        for (EightPuzzleState* next : nextStates) {
-            std::string hashCode = next->getHashCode();
-            
-            // 如果该状态已经在闭集中，则释放内存并继续
-            if (closedList.find(hashCode) != closedList.end()) {
-                delete next;
+        // 生成下一步可能的状态
+        // 贪心算法不关心路径长度，同一状态的h值不变，因此每个状态只入队一次
+        for (int dir = 0; dir < 4; ++dir) {
+            const SearchNode& node = pool[current];
+            int nextEmpty = movedEmptyPos(node.emptyPos, dir);
+            if (nextEmpty < 0) {
+                continue;
+            }
+            PackedBoard nextBoard = slideTile(node.board, node.emptyPos, nextEmpty);
+            lastStatistics.nodesGenerated++;
+            if (pool.find(nextBoard) >= 0) {
                 continue;
             }
             
-            // 计算启发式函数值（曼哈顿距离）
-            next->setHValue(next->calculateManhattanDistance());
-            
-            // 在贪心算法中，我们忽略g值，只考虑h值
-            // 为了重用StateComparison结构，我们将g值设为0，这样比较时就只看h值
-            next->setGValue(0);
-            
-            // 检查是否已经在开放列表中有相同的状态
-            if (allStates.find(hashCode) != allStates.end()) {
-                // 在贪心算法中，我们不关心路径长度，只关心启发式估计
-                // 如果新状态的h值更小，则更新
-                EightPuzzleState* existingState = allStates[hashCode];
-                if (next->getHValue() < existingState->getHValue()) {
-                    // 更新现有状态的父状态和动作
-                    existingState->setParent(current);
-                    existingState->setAction(next->getAction());
-                    existingState->setHValue(next->getHValue());
-                }
-                // 释放新创建的状态，因为我们已经有相同的状态
-                delete next;
-            } else {
-                // 加入新状态到开放列表和所有状态映射
-                openList.push(next);
-                allStates[hashCode] = next;
+            // 计算启发式函数值
+            int nextH = evaluateBoard(nextBoard, heuristic);
+            int nextG = node.gValue + 1;
+            int next = pool.allocate(nextBoard, nextEmpty, current, MOVES[dir], nextG, nextH,
+                                     openList.pushGrowth(nextH, nextG));
+            if (next < 0) {
+                lastStatistics.budgetExceeded = true;
+                break;
             }
+            openList.push(nextH, nextG, next);
+            pool.setFrontierBytes(openList.bytesUsed());
         }
+        lastStatistics.peakOpenSize = std::max(lastStatistics.peakOpenSize, openList.size());
     }
     
-    std::cout << "搜索超出限制，未找到解决方案！" << std::endl;
-    
-    // 释放所有创建的状态
-    for (auto& pair : allStates) {
-        delete pair.second;
+    lastStatistics.nodesExplored = nodesExplored;
+    lastStatistics.peakBytes = pool.getPeakBytes();
+    reportFailure(lastStatistics, memoryBudget, verbose);
+    return ""; // 如果找不到解决方案，返回空串
+}
+
+// A*超出内存预算后的退路：从给定f阈值开始做IDA*
+// 每轮把阈值提高到上一轮被剪掉分支中的最小f值，找到的第一个解就是最优解
+std::string EightPuzzleSolver::fallbackIDAStar(PackedBoard board, int emptyPos, HeuristicType heuristic, int bound) {
+    if (verbose) {
+        std::cout << "超出内存预算（" << memoryBudget / 1024 << " KB），从f=" << bound << "开始改用IDA*继续搜索" << std::endl;
     }
     
-    return solution; // 如果找不到解决方案，返回空向量
+    IDAStarSearch search;
+    search.heuristic = heuristic;
+    search.nodesExplored = 0;
+    
+    while (true) {
+        search.nextBound = INT_MAX;
+        search.path.clear();
+        bool found = search.search(board, emptyPos, 0, bound, -1);
+        lastStatistics.nodesExplored += search.nodesExplored;
+        search.nodesExplored = 0;
+        
+        if (found) {
+            lastStatistics.solutionSteps = static_cast<int>(search.path.size());
+            return search.path;
+        }
+        if (search.nextBound == INT_MAX) {
+            reportFailure(lastStatistics, memoryBudget, verbose);
+            return "";
+        }
+        bound = search.nextBound;
+    }
+}
+
+// 设置每次搜索中节点池可用的内存
+void EightPuzzleSolver::setMemoryBudget(size_t bytes) {
+    memoryBudget = bytes;
+}
+
+// 获取每次搜索中节点池可用的内存
+size_t EightPuzzleSolver::getMemoryBudget() const {
+    return memoryBudget;
+}
+
+// 获取最近一次搜索的统计信息
+const SearchStatistics& EightPuzzleSolver::getLastStatistics() const {
+    return lastStatistics;
+}
+
+// 设置是否打印搜索过程
+void EightPuzzleSolver::setVerbose(bool v) {
+    verbose = v;
+}
+
+// 将移动串从初始状态回放为状态序列
+std::vector<EightPuzzleState> EightPuzzleSolver::replaySolution(const EightPuzzleState& initial, const std::string& moves) {
+    std::vector<EightPuzzleState> states;
+    states.push_back(initial);
+    for (char move : moves) {
+        EightPuzzleState next(states.back());
+        if (!next.applyMove(move)) {
+            break;
+        }
+        states.push_back(next);
+    }
+    return states;
 }
 
 // 打印解决方案
-void EightPuzzleSolver::printSolution(const std::vector<EightPuzzleState*>& solution) {
-    if (solution.empty()) {
+void EightPuzzleSolver::printSolution(const std::string& moves) {
+    if (lastStatistics.solutionSteps < 0) {
         std::cout << "无解决方案！" << std::endl;
         return;
     }
     
-    std::cout << "解决方案步数：" << solution.size() - 1 << std::endl;
+    std::cout << "解决方案步数：" << moves.size() << std::endl;
     
-    for (size_t i = 0; i < solution.size(); ++i) {
+    std::vector<EightPuzzleState> states = replaySolution(*initialState, moves);
+    for (size_t i = 0; i < states.size(); ++i) {
         std::cout << "Step " << i << ":" << std::endl;
-        displayColorState(*solution[i]); // 使用彩色显示替代printState
-        if (i < solution.size() - 1) {
-            std::cout << "动作：" << solution[i + 1]->getAction() << std::endl;
+        displayColorState(states[i]); // 使用彩色显示替代printState
+        if (i < states.size() - 1) {
+            std::cout << "动作：" << states[i + 1].getAction() << std::endl;
         }
         std::cout << "------------------------" << std::endl;
     }
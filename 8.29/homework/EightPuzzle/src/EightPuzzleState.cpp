@@ -2,6 +2,212 @@
 #include <iostream>
 #include <sstream>
 #include <cmath>
+#include <queue>
+
+namespace {
+
+// 行走距离表的编码：3x3的计数矩阵每项占2位，再加上空格所在行（或列）占2位
+const int WD_TABLE_SIZE = 1 << 20;
+
+// 计数矩阵counts[line][goal]：第line行（列）中目标行（列）为goal的数字个数
+int encodeWalkingDistance(const int counts[3][3], int blankLine) {
+    int code = blankLine;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            code = (code << 2) | counts[i][j];
+        }
+    }
+    return code;
+}
+
+// 从目标状态出发做BFS，预计算所有计数矩阵到目标的最少垂直移动步数
+// 目标状态中空格位于右下角，因此行表和列表的结构完全相同，可以共用一张表
+const std::vector<unsigned char>& getWalkingDistanceTable() {
+    static std::vector<unsigned char> table;
+    if (!table.empty()) {
+        return table;
+    }
+    table.assign(WD_TABLE_SIZE, 255);
+
+    struct WDNode {
+        int counts[3][3];
+        int blankLine;
+    };
+
+    WDNode goal = {{{3, 0, 0}, {0, 3, 0}, {0, 0, 2}}, 2};
+    std::queue<WDNode> queue;
+    table[encodeWalkingDistance(goal.counts, goal.blankLine)] = 0;
+    queue.push(goal);
+
+    while (!queue.empty()) {
+        WDNode current = queue.front();
+        queue.pop();
+        int distance = table[encodeWalkingDistance(current.counts, current.blankLine)];
+
+        // 空格只能与相邻行（列）中的某个数字交换
+        for (int dir = -1; dir <= 1; dir += 2) {
+            int neighborLine = current.blankLine + dir;
+            if (neighborLine < 0 || neighborLine >= 3) {
+                continue;
+            }
+            for (int g = 0; g < 3; ++g) {
+                if (current.counts[neighborLine][g] == 0) {
+                    continue;
+                }
+                WDNode next = current;
+                next.counts[neighborLine][g]--;
+                next.counts[current.blankLine][g]++;
+                next.blankLine = neighborLine;
+
+                int code = encodeWalkingDistance(next.counts, next.blankLine);
+                if (table[code] == 255) {
+                    table[code] = static_cast<unsigned char>(distance + 1);
+                    queue.push(next);
+                }
+            }
+        }
+    }
+
+    return table;
+}
+
+// 计算一条线上互相冲突的数字需要让路的最少个数
+// goals按在线上的顺序给出各数字的目标位置，最少让路数 = 长度 - 最长递增子序列长度
+int countLineConflicts(const int goals[], int length) {
+    int lis[3] = {0, 0, 0};
+    int longest = 0;
+    for (int i = 0; i < length; ++i) {
+        lis[i] = 1;
+        for (int j = 0; j < i; ++j) {
+            if (goals[j] < goals[i] && lis[j] + 1 > lis[i]) {
+                lis[i] = lis[j] + 1;
+            }
+        }
+        if (lis[i] > longest) {
+            longest = lis[i];
+        }
+    }
+    return length - longest;
+}
+
+// 曼哈顿距离：每个数字从当前位置到目标位置需要移动的最小步数之和
+int manhattanDistance(const int tiles[9]) {
+    int distance = 0;
+    for (int pos = 0; pos < 9; ++pos) {
+        int value = tiles[pos];
+        if (value != 0) { // 不计算空格的距离
+            int targetPos = value - 1;
+            distance += std::abs(pos / 3 - targetPos / 3) + std::abs(pos % 3 - targetPos % 3);
+        }
+    }
+    return distance;
+}
+
+// 不在位数：有多少数字不在其目标位置上
+int misplacedTiles(const int tiles[9]) {
+    int count = 0;
+    for (int pos = 0; pos < 9; ++pos) {
+        if (tiles[pos] != 0 && tiles[pos] != pos + 1) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// 线性冲突：同一行中两个数字的目标行都是该行且相对顺序颠倒时，其中一个必须先移出该行再移回，
+// 至少多走2步；列同理。每条线上只统计必须让路的最少数字个数，保证启发值可接受
+int linearConflicts(const int tiles[9]) {
+    int conflicts = 0;
+    for (int i = 0; i < 3; ++i) {
+        // 检查行：收集目标行为i的数字的目标列
+        int rowGoals[3];
+        int rowLength = 0;
+        // 检查列：收集目标列为i的数字的目标行
+        int colGoals[3];
+        int colLength = 0;
+
+        for (int j = 0; j < 3; ++j) {
+            int rowValue = tiles[i * 3 + j];
+            if (rowValue != 0 && (rowValue - 1) / 3 == i) {
+                rowGoals[rowLength++] = (rowValue - 1) % 3;
+            }
+            int colValue = tiles[j * 3 + i];
+            if (colValue != 0 && (colValue - 1) % 3 == i) {
+                colGoals[colLength++] = (colValue - 1) / 3;
+            }
+        }
+
+        conflicts += countLineConflicts(rowGoals, rowLength);
+        conflicts += countLineConflicts(colGoals, colLength);
+    }
+    return conflicts;
+}
+
+// 行走距离：只考虑每个数字位于哪一行（列），而不关心具体列（行），
+// 垂直方向和水平方向的移动互不重叠，两张表的值相加仍然可接受
+int walkingDistance(const int tiles[9]) {
+    const std::vector<unsigned char>& table = getWalkingDistanceTable();
+
+    int rowCounts[3][3] = {{0}};
+    int colCounts[3][3] = {{0}};
+    int emptyRow = 2;
+    int emptyCol = 2;
+
+    for (int pos = 0; pos < 9; ++pos) {
+        int value = tiles[pos];
+        if (value != 0) {
+            rowCounts[pos / 3][(value - 1) / 3]++;
+            colCounts[pos % 3][(value - 1) % 3]++;
+        } else {
+            emptyRow = pos / 3;
+            emptyCol = pos % 3;
+        }
+    }
+
+    return table[encodeWalkingDistance(rowCounts, emptyRow)] +
+           table[encodeWalkingDistance(colCounts, emptyCol)];
+}
+
+} // namespace
+
+// 获取开放列表实现方式的名称
+const char* getOpenListName(OpenListType type) {
+    switch (type) {
+    case OpenListType::BINARY_HEAP:
+        return "二叉堆";
+    case OpenListType::BUCKET_LIFO:
+        return "分桶-LIFO";
+    case OpenListType::BUCKET_HIGH_G:
+        return "分桶-深g优先";
+    }
+    return "未知";
+}
+
+// 获取空格移动方向的中文名称
+const char* getMoveName(char move) {
+    switch (move) {
+    case 'U': return "上";
+    case 'D': return "下";
+    case 'L': return "左";
+    case 'R': return "右";
+    }
+    return "";
+}
+
+// 获取启发式函数的名称
+const char* getHeuristicName(HeuristicType type) {
+    switch (type) {
+    case HeuristicType::MANHATTAN:
+        return "曼哈顿距离";
+    case HeuristicType::MISPLACED_TILES:
+        return "不在位数";
+    case HeuristicType::LINEAR_CONFLICT:
+        return "线性冲突";
+    case HeuristicType::WALKING_DISTANCE:
+        return "行走距离";
+    }
+    return "未知";
+}
 
 // 默认构造函数
 EightPuzzleState::EightPuzzleState() {
@@ -88,46 +294,52 @@ int EightPuzzleState::getGValue() const {
 
 // 计算曼哈顿距离
 int EightPuzzleState::calculateManhattanDistance() const {
-    int distance = 0;
-    
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            int value = board[i][j];
-            if (value != 0) { // 不计算空格的距离
-                // 计算该数字在目标状态中的位置
-                int targetRow = (value - 1) / 3;
-                int targetCol = (value - 1) % 3;
-                
-                // 计算曼哈顿距离（行距离 + 列距离）
-                distance += std::abs(i - targetRow) + std::abs(j - targetCol);
-            }
-        }
-    }
-    
-    return distance;
+    int tiles[9];
+    flatten(tiles);
+    return calculateHeuristic(tiles, HeuristicType::MANHATTAN);
 }
 
 // 计算不在位数
 int EightPuzzleState::calculateMisplacedTiles() const {
-    int count = 0;
-    
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            int value = board[i][j];
-            if (value != 0) { // 不计算空格
-                // 计算该数字在目标状态中的位置
-                int targetRow = (value - 1) / 3;
-                int targetCol = (value - 1) % 3;
-                
-                // 如果不在正确位置上，计数加一
-                if (i != targetRow || j != targetCol) {
-                    count++;
-                }
-            }
-        }
+    int tiles[9];
+    flatten(tiles);
+    return calculateHeuristic(tiles, HeuristicType::MISPLACED_TILES);
+}
+
+// 计算线性冲突启发值
+int EightPuzzleState::calculateLinearConflict() const {
+    int tiles[9];
+    flatten(tiles);
+    return calculateHeuristic(tiles, HeuristicType::LINEAR_CONFLICT);
+}
+
+// 计算行走距离启发值
+int EightPuzzleState::calculateWalkingDistance() const {
+    int tiles[9];
+    flatten(tiles);
+    return calculateHeuristic(tiles, HeuristicType::WALKING_DISTANCE);
+}
+
+// 按指定类型计算启发式函数值
+int EightPuzzleState::calculateHeuristic(HeuristicType type) const {
+    int tiles[9];
+    flatten(tiles);
+    return calculateHeuristic(tiles, type);
+}
+
+// 对一维棋盘按指定类型计算启发式函数值
+int EightPuzzleState::calculateHeuristic(const int tiles[9], HeuristicType type) {
+    switch (type) {
+    case HeuristicType::MISPLACED_TILES:
+        return misplacedTiles(tiles);
+    case HeuristicType::LINEAR_CONFLICT:
+        return manhattanDistance(tiles) + 2 * linearConflicts(tiles);
+    case HeuristicType::WALKING_DISTANCE:
+        return walkingDistance(tiles);
+    case HeuristicType::MANHATTAN:
+    default:
+        return manhattanDistance(tiles);
     }
-    
-    return count;
 }
 
 // 设置h值
@@ -232,6 +444,40 @@ bool EightPuzzleState::equals(const EightPuzzleState& other) const {
     return getHashCode() == other.getHashCode();
 }
 
+// 按空格的移动方向（'U'、'D'、'L'、'R'）移动一步，移动越界时返回false
+bool EightPuzzleState::applyMove(char move) {
+    int newRow = emptyRow;
+    int newCol = emptyCol;
+    switch (move) {
+    case 'U': newRow--; break;
+    case 'D': newRow++; break;
+    case 'L': newCol--; break;
+    case 'R': newCol++; break;
+    default: return false;
+    }
+    
+    if (newRow < 0 || newRow >= 3 || newCol < 0 || newCol >= 3) {
+        return false;
+    }
+    
+    board[emptyRow][emptyCol] = board[newRow][newCol];
+    board[newRow][newCol] = 0;
+    emptyRow = newRow;
+    emptyCol = newCol;
+    action = getMoveName(move);
+    gValue++;
+    return true;
+}
+
+// 将棋盘按行优先展开为一维数组
+void EightPuzzleState::flatten(int tiles[9]) const {
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            tiles[i * 3 + j] = board[i][j];
+        }
+    }
+}
+
 // 初始化空格位置
 void EightPuzzleState::findEmptyPosition() {
     for (int i = 0; i < 3; ++i) {
@@ -0,0 +1,27 @@
+@echo off
+:: 设置UTF-8编码，确保中文显示正常
+chcp 65001 > nul
+echo 编译八数码基准测试程序（开启优化，去掉搜索过程打印）...
+
+:: 编译程序
+D:\msys2\clang64\bin\c++.exe -std=c++17 -O2 -DEIGHT_PUZZLE_NO_TRACE -o EightPuzzleBench.exe main.cpp EightPuzzleState.cpp EightPuzzleSolver.cpp -I.
+
+if %ERRORLEVEL% neq 0 (
+    echo 编译失败！
+    pause
+    exit /b 1
+)
+
+echo 编译成功！
+
+:: 参数：实例数 随机种子 输出CSV文件
+set COUNT=%1
+set SEED=%2
+set OUTPUT=%3
+if "%COUNT%"=="" set COUNT=100
+if "%SEED%"=="" set SEED=2025
+if "%OUTPUT%"=="" set OUTPUT=bench.csv
+
+echo 运行基准测试：%COUNT% 个实例，随机种子 %SEED%，结果写入 %OUTPUT%
+echo ====================================
+EightPuzzleBench.exe --bench %COUNT% %SEED% %OUTPUT%
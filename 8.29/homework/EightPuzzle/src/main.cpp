@@ -6,6 +6,11 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <random>
+#include <algorithm>
+#include <fstream>
+#include <cstdlib>
+#include <sstream>
 
 // 定义目标状态
 const std::vector<std::vector<int>> GOAL_STATE = {
@@ -93,126 +98,80 @@ void displayColorState(const EightPuzzleState &state)
 }
 
 // 可视化解决方案
-void visualizeSolution(const std::vector<EightPuzzleState *> &solution)
+void visualizeSolution(const std::string &moves, bool solved)
 {
-    if (solution.empty())
+    if (!solved)
     {
         std::cout << "无解决方案！" << std::endl;
         return;
     }
 
-    std::cout << "解决方案步数：" << solution.size() - 1 << std::endl;
-
-    // 删除了详细步骤显示，只显示解决方案步数
-    // 原来的详细步骤输出代码已被移除
+    std::cout << "解决方案步数：" << moves.size() << std::endl;
+    std::cout << "移动序列（空格方向）：" << (moves.empty() ? "-" : moves) << std::endl;
 }
 
-// 验证解决方案的正确性
-bool verifySolution(const std::vector<EightPuzzleState *> &solution)
+// 验证解决方案的正确性：从初始状态逐步执行移动串，检查每一步是否合法以及最终是否到达目标
+bool verifySolution(const std::vector<std::vector<int>> &initialState, const std::string &moves, bool solved)
 {
-    if (solution.empty())
+    if (!solved)
     {
         std::cout << "无解决方案可验证！" << std::endl;
         return false;
     }
 
-    // 检查每一步是否是合法移动
-    for (size_t i = 1; i < solution.size(); ++i)
-    {
-        EightPuzzleState *prev = solution[i - 1];
-        EightPuzzleState *curr = solution[i];
+    std::vector<std::vector<int>> board = initialState;
 
-        // 找到空格在prev中的位置
-        int emptyRow = -1, emptyCol = -1;
-        auto prevBoard = prev->getBoard();
-
-        for (int r = 0; r < 3; ++r)
+    // 找到空格的位置
+    int emptyRow = -1, emptyCol = -1;
+    for (int r = 0; r < 3 && emptyRow == -1; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
         {
-            for (int c = 0; c < 3; ++c)
+            if (board[r][c] == 0)
             {
-                if (prevBoard[r][c] == 0)
-                {
-                    emptyRow = r;
-                    emptyCol = c;
-                    break;
-                }
-            }
-            if (emptyRow != -1)
+                emptyRow = r;
+                emptyCol = c;
                 break;
+            }
         }
+    }
 
-        // 获取当前动作
-        std::string action = curr->getAction();
-
-        // 基于动作计算期望的新状态
-        std::vector<std::vector<int>> expectedBoard = prevBoard;
-        if (action == "上" && emptyRow > 0)
+    // 检查每一步是否是合法移动
+    for (size_t i = 0; i < moves.size(); ++i)
+    {
+        int newRow = emptyRow, newCol = emptyCol;
+        char action = moves[i];
+        if (action == 'U' && emptyRow > 0)
         {
-            // 空格向上移动（数字向下移动）
-            expectedBoard[emptyRow][emptyCol] = expectedBoard[emptyRow - 1][emptyCol];
-            expectedBoard[emptyRow - 1][emptyCol] = 0;
+            newRow--; // 空格向上移动（数字向下移动）
         }
-        else if (action == "下" && emptyRow < 2)
+        else if (action == 'D' && emptyRow < 2)
         {
-            // 空格向下移动（数字向上移动）
-            expectedBoard[emptyRow][emptyCol] = expectedBoard[emptyRow + 1][emptyCol];
-            expectedBoard[emptyRow + 1][emptyCol] = 0;
+            newRow++; // 空格向下移动（数字向上移动）
         }
-        else if (action == "左" && emptyCol > 0)
+        else if (action == 'L' && emptyCol > 0)
         {
-            // 空格向左移动（数字向右移动）
-            expectedBoard[emptyRow][emptyCol] = expectedBoard[emptyRow][emptyCol - 1];
-            expectedBoard[emptyRow][emptyCol - 1] = 0;
+            newCol--; // 空格向左移动（数字向右移动）
         }
-        else if (action == "右" && emptyCol < 2)
+        else if (action == 'R' && emptyCol < 2)
         {
-            // 空格向右移动（数字向左移动）
-            expectedBoard[emptyRow][emptyCol] = expectedBoard[emptyRow][emptyCol + 1];
-            expectedBoard[emptyRow][emptyCol + 1] = 0;
+            newCol++; // 空格向右移动（数字向左移动）
         }
         else
         {
-            std::cout << "无效动作：" << action << " 在位置 [" << emptyRow << "," << emptyCol << "]" << std::endl;
+            std::cout << "无效动作：" << action << " 在步骤 " << i + 1
+                      << " 位置 [" << emptyRow << "," << emptyCol << "]" << std::endl;
             return false;
         }
 
-        // 比较期望的新状态与实际状态
-        auto currBoard = curr->getBoard();
-        for (int r = 0; r < 3; ++r)
-        {
-            for (int c = 0; c < 3; ++c)
-            {
-                if (expectedBoard[r][c] != currBoard[r][c])
-                {
-                    std::cout << "状态不匹配 在步骤 " << i << std::endl;
-                    std::cout << "期望：" << std::endl;
-                    for (int r2 = 0; r2 < 3; ++r2)
-                    {
-                        for (int c2 = 0; c2 < 3; ++c2)
-                        {
-                            std::cout << expectedBoard[r2][c2] << " ";
-                        }
-                        std::cout << std::endl;
-                    }
-
-                    std::cout << "实际：" << std::endl;
-                    for (int r2 = 0; r2 < 3; ++r2)
-                    {
-                        for (int c2 = 0; c2 < 3; ++c2)
-                        {
-                            std::cout << currBoard[r2][c2] << " ";
-                        }
-                        std::cout << std::endl;
-                    }
-
-                    return false;
-                }
-            }
-        }
+        board[emptyRow][emptyCol] = board[newRow][newCol];
+        board[newRow][newCol] = 0;
+        emptyRow = newRow;
+        emptyCol = newCol;
     }
 
     // 验证最终状态是否为目标状态
-    if (!solution.back()->isGoal())
+    if (board != GOAL_STATE)
     {
         std::cout << "最终状态不是目标状态！" << std::endl;
         return false;
@@ -225,36 +184,69 @@ bool verifySolution(const std::vector<EightPuzzleState *> &solution)
 struct AlgorithmPerformance
 {
     int nodesExplored;
+    int nodesGenerated;
+    int nodesReopened;
+    int nodesAtSolutionF;
+    int initialH;
+    size_t peakBytes;
+    size_t peakOpenSize;
+    int fallbackBound;
     double timeMs;
     int solutionSteps;
     bool solved;
 
-    AlgorithmPerformance() : nodesExplored(0), timeMs(0), solutionSteps(0), solved(false) {}
+    AlgorithmPerformance()
+        : nodesExplored(0), nodesGenerated(0), nodesReopened(0), nodesAtSolutionF(0), initialH(0), peakBytes(0),
+          peakOpenSize(0), fallbackBound(-1), timeMs(0), solutionSteps(0), solved(false) {}
 };
 
+// 所有可选的启发式函数，顺序与菜单编号一致
+const HeuristicType ALL_HEURISTICS[] = {
+    HeuristicType::MANHATTAN,
+    HeuristicType::MISPLACED_TILES,
+    HeuristicType::LINEAR_CONFLICT,
+    HeuristicType::WALKING_DISTANCE};
+
+// 所有可选的开放列表实现，顺序与菜单编号一致
+const OpenListType ALL_OPEN_LISTS[] = {
+    OpenListType::BINARY_HEAP,
+    OpenListType::BUCKET_LIFO,
+    OpenListType::BUCKET_HIGH_G};
+
 // 运行指定的算法
-std::pair<std::vector<EightPuzzleState *>, AlgorithmPerformance>
-runAlgorithmWithPerformance(const std::vector<std::vector<int>> &initialState, const std::string &algorithm)
+std::pair<std::string, AlgorithmPerformance>
+runAlgorithmWithPerformance(const std::vector<std::vector<int>> &initialState, const std::string &algorithm,
+                            HeuristicType heuristic = HeuristicType::MANHATTAN,
+                            OpenListType openListType = OpenListType::BUCKET_HIGH_G, bool verbose = true,
+                            size_t memoryBudget = EightPuzzleSolver::DEFAULT_MEMORY_BUDGET)
 {
-    std::cout << "--------------------------------" << std::endl;
-    std::cout << "使用" << algorithm << "算法解决八数码问题" << std::endl;
-    std::cout << "--------------------------------" << std::endl;
+    if (verbose)
+    {
+        std::cout << "--------------------------------" << std::endl;
+        std::cout << "使用" << algorithm << "算法解决八数码问题";
+        if (algorithm != "BFS")
+        {
+            std::cout << "（启发式函数：" << getHeuristicName(heuristic)
+                      << "，开放列表：" << getOpenListName(openListType) << "）";
+        }
+        std::cout << std::endl;
+        std::cout << "--------------------------------" << std::endl;
 
-    std::cout << "初始状态：" << std::endl;
-    EightPuzzleState initialStateObj(initialState);
-    displayColorState(initialStateObj);
+        std::cout << "初始状态：" << std::endl;
+        EightPuzzleState initialStateObj(initialState);
+        displayColorState(initialStateObj);
 
-    std::cout << "目标状态：" << std::endl;
-    EightPuzzleState goalStateObj(GOAL_STATE);
-    displayColorState(goalStateObj);
+        std::cout << "目标状态：" << std::endl;
+        EightPuzzleState goalStateObj(GOAL_STATE);
+        displayColorState(goalStateObj);
+    }
 
     EightPuzzleSolver solver(initialState, GOAL_STATE);
+    solver.setVerbose(verbose);
+    solver.setMemoryBudget(memoryBudget);
 
     auto start = std::chrono::high_resolution_clock::now();
-    std::vector<EightPuzzleState *> solution;
-
-    // 记录搜索节点数的变量
-    int nodesExplored = 0;
+    std::string solution;
 
     if (algorithm == "BFS")
     {
@@ -262,58 +254,408 @@ runAlgorithmWithPerformance(const std::vector<std::vector<int>> &initialState, c
     }
     else if (algorithm == "A*")
     {
-        solution = solver.solveAStar();
+        solution = solver.solveAStar(heuristic, openListType);
     }
     else if (algorithm == "Greedy")
     {
-        solution = solver.solveGreedy();
+        solution = solver.solveGreedy(heuristic, openListType);
     }
 
     auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
 
-    std::cout << "求解耗时：" << duration.count() << " ms" << std::endl;
+    if (verbose)
+    {
+        std::cout << "求解耗时：" << duration.count() / 1000.0 << " ms" << std::endl;
+    }
 
-    // 创建性能数据结构
+    // 创建性能数据结构，节点数从求解器的统计信息中获取
+    const SearchStatistics &stats = solver.getLastStatistics();
     AlgorithmPerformance perf;
-    perf.timeMs = duration.count();
-    perf.solved = !solution.empty();
-    perf.solutionSteps = perf.solved ? solution.size() - 1 : -1;
-
-    // 此处简化了节点探索数的获取，实际项目中可能需要从算法实现中获取
-    // 在这个简化版本中，我们可以在算法内部记录探索节点数并返回
+    perf.nodesExplored = stats.nodesExplored;
+    perf.nodesGenerated = stats.nodesGenerated;
+    perf.nodesReopened = stats.nodesReopened;
+    perf.nodesAtSolutionF = stats.nodesAtSolutionF;
+    perf.initialH = stats.initialH;
+    perf.peakBytes = stats.peakBytes;
+    perf.peakOpenSize = stats.peakOpenSize;
+    perf.fallbackBound = stats.fallbackBound;
+    perf.timeMs = duration.count() / 1000.0;
+    perf.solutionSteps = stats.solutionSteps;
+    perf.solved = stats.solutionSteps >= 0;
 
     return {solution, perf};
 }
 
 // 运行算法并显示结果
-void runAlgorithm(const std::vector<std::vector<int>> &initialState, const std::string &algorithm)
+void runAlgorithm(const std::vector<std::vector<int>> &initialState, const std::string &algorithm,
+                  HeuristicType heuristic = HeuristicType::MANHATTAN,
+                  OpenListType openListType = OpenListType::BUCKET_HIGH_G)
 {
-    auto [solution, performance] = runAlgorithmWithPerformance(initialState, algorithm);
+    auto [solution, performance] = runAlgorithmWithPerformance(initialState, algorithm, heuristic, openListType);
 
-    visualizeSolution(solution);
+    visualizeSolution(solution, performance.solved);
+    std::cout << "扩展节点数：" << performance.nodesExplored << std::endl;
+    if (algorithm != "BFS")
+    {
+        std::cout << "重新打开的节点数：" << performance.nodesReopened << std::endl;
+        std::cout << "f值等于解长度的扩展节点数：" << performance.nodesAtSolutionF << std::endl;
+    }
+    std::cout << "峰值内存（节点池和开放列表）：" << performance.peakBytes / 1024.0 << " KB" << std::endl;
+    if (performance.fallbackBound >= 0)
+    {
+        std::cout << "超出内存预算，从f=" << performance.fallbackBound << "开始改用IDA*求解" << std::endl;
+    }
 
     // 验证解决方案的正确性
-    bool isValid = verifySolution(solution);
+    bool isValid = verifySolution(initialState, solution, performance.solved);
     std::cout << "解决方案验证结果: " << (isValid ? "正确" : "错误") << std::endl;
 }
 
-int main()
+// 按终端显示宽度补齐字符串（中文字符占两列）
+std::string padDisplay(const std::string &text, int width)
+{
+    int displayWidth = 0;
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if ((c & 0xC0) != 0x80)
+        {
+            displayWidth += (c < 0x80) ? 1 : 2;
+        }
+    }
+    return text + std::string(displayWidth < width ? width - displayWidth : 1, ' ');
+}
+
+// 对同一初始状态运行所有算法和启发式函数，并排比较性能
+void compareAllAlgorithms(const std::vector<std::vector<int>> &initialState)
+{
+    std::cout << "初始状态：" << std::endl;
+    displayColorState(EightPuzzleState(initialState));
+
+    std::cout << padDisplay("算法", 10)
+              << padDisplay("启发式函数", 14)
+              << padDisplay("开放列表", 16)
+              << padDisplay("h(初始)", 10)
+              << padDisplay("扩展节点", 12)
+              << padDisplay("生成节点", 12)
+              << padDisplay("重开", 8)
+              << padDisplay("f=解长", 10)
+              << padDisplay("步数", 8)
+              << "耗时(ms)" << std::endl;
+
+    auto printRow = [](const std::string &algorithm, const std::string &heuristicName, const std::string &openListName,
+                       const AlgorithmPerformance &perf)
+    {
+        std::cout << padDisplay(algorithm, 10)
+                  << padDisplay(heuristicName, 14)
+                  << padDisplay(openListName, 16)
+                  << padDisplay(std::to_string(perf.initialH), 10)
+                  << padDisplay(std::to_string(perf.nodesExplored), 12)
+                  << padDisplay(std::to_string(perf.nodesGenerated), 12)
+                  << padDisplay(std::to_string(perf.nodesReopened), 8)
+                  << padDisplay(std::to_string(perf.nodesAtSolutionF), 10)
+                  << padDisplay(std::to_string(perf.solutionSteps), 8)
+                  << perf.timeMs << std::endl;
+    };
+
+    auto bfsPerf = runAlgorithmWithPerformance(initialState, "BFS", HeuristicType::MANHATTAN,
+                                               OpenListType::BINARY_HEAP, false).second;
+    printRow("BFS", "-", "-", bfsPerf);
+
+    // A*分别用二叉堆和深g优先分桶运行，对比同f值节点的处理顺序对扩展节点数的影响
+    for (OpenListType openListType : {OpenListType::BINARY_HEAP, OpenListType::BUCKET_HIGH_G})
+    {
+        for (HeuristicType heuristic : ALL_HEURISTICS)
+        {
+            auto perf = runAlgorithmWithPerformance(initialState, "A*", heuristic, openListType, false).second;
+            printRow("A*", getHeuristicName(heuristic), getOpenListName(openListType), perf);
+        }
+    }
+
+    for (HeuristicType heuristic : ALL_HEURISTICS)
+    {
+        auto perf = runAlgorithmWithPerformance(initialState, "Greedy", heuristic, OpenListType::BUCKET_LIFO, false).second;
+        printRow("Greedy", getHeuristicName(heuristic), getOpenListName(OpenListType::BUCKET_LIFO), perf);
+    }
+}
+
+// 选择启发式函数
+HeuristicType chooseHeuristic()
+{
+    std::cout << "\n选择启发式函数：" << std::endl;
+    std::cout << "1. 曼哈顿距离" << std::endl;
+    std::cout << "2. 不在位数" << std::endl;
+    std::cout << "3. 曼哈顿距离 + 线性冲突" << std::endl;
+    std::cout << "4. 行走距离" << std::endl;
+    std::cout << "请选择启发式函数(1-4): ";
+
+    int heuristicChoice;
+    std::cin >> heuristicChoice;
+
+    if (heuristicChoice < 1 || heuristicChoice > 4)
+    {
+        std::cout << "无效的启发式函数选择，使用默认曼哈顿距离" << std::endl;
+        heuristicChoice = 1;
+    }
+
+    return ALL_HEURISTICS[heuristicChoice - 1];
+}
+
+// 选择开放列表实现
+OpenListType chooseOpenList(OpenListType defaultType)
+{
+    std::cout << "\n选择开放列表：" << std::endl;
+    std::cout << "1. 二叉堆（同优先级顺序不确定）" << std::endl;
+    std::cout << "2. 分桶，桶内后进先出" << std::endl;
+    std::cout << "3. 分桶，桶内深g优先" << std::endl;
+    std::cout << "请选择开放列表(1-3): ";
+
+    int openListChoice;
+    std::cin >> openListChoice;
+
+    if (openListChoice < 1 || openListChoice > 3)
+    {
+        std::cout << "无效的开放列表选择，使用默认的" << getOpenListName(defaultType) << std::endl;
+        return defaultType;
+    }
+
+    return ALL_OPEN_LISTS[openListChoice - 1];
+}
+
+// 按固定小数位格式化浮点数
+std::string formatFixed(double value)
+{
+    std::ostringstream oss;
+    oss << std::setprecision(2) << std::fixed << value;
+    return oss.str();
+}
+
+// 启发式函数在CSV中的标识
+const char *heuristicKey(HeuristicType type)
+{
+    switch (type)
+    {
+    case HeuristicType::MANHATTAN:
+        return "manhattan";
+    case HeuristicType::MISPLACED_TILES:
+        return "misplaced";
+    case HeuristicType::LINEAR_CONFLICT:
+        return "linear_conflict";
+    case HeuristicType::WALKING_DISTANCE:
+        return "walking_distance";
+    }
+    return "unknown";
+}
+
+// 开放列表在CSV中的标识
+const char *openListKey(OpenListType type)
+{
+    switch (type)
+    {
+    case OpenListType::BINARY_HEAP:
+        return "heap";
+    case OpenListType::BUCKET_LIFO:
+        return "bucket_lifo";
+    case OpenListType::BUCKET_HIGH_G:
+        return "bucket_high_g";
+    }
+    return "unknown";
+}
+
+// 随机生成一个可解的初始状态
+// 目标状态的逆序数为0，因此初始状态的逆序数必须为偶数；为奇数时交换两个数字即可改变奇偶性
+std::vector<std::vector<int>> generateSolvableInstance(std::mt19937 &rng)
+{
+    // 手写Fisher-Yates洗牌，直接使用mt19937的输出：std::shuffle和uniform_int_distribution的结果依赖标准库实现，
+    // 同一个种子在libstdc++和libc++下会得到不同的棋盘
+    std::vector<int> tiles = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    for (int i = 8; i > 0; --i)
+    {
+        int j = static_cast<int>(rng() % static_cast<unsigned>(i + 1));
+        std::swap(tiles[i], tiles[j]);
+    }
+
+    int inversions = 0;
+    for (int i = 0; i < 9; ++i)
+    {
+        for (int j = i + 1; j < 9; ++j)
+        {
+            if (tiles[i] != 0 && tiles[j] != 0 && tiles[i] > tiles[j])
+            {
+                inversions++;
+            }
+        }
+    }
+
+    if (inversions % 2 != 0)
+    {
+        int first = (tiles[0] != 0) ? 0 : 1;
+        int second = (tiles[first + 1] != 0) ? first + 1 : first + 2;
+        std::swap(tiles[first], tiles[second]);
+    }
+
+    std::vector<std::vector<int>> board(3, std::vector<int>(3));
+    for (int pos = 0; pos < 9; ++pos)
+    {
+        board[pos / 3][pos % 3] = tiles[pos];
+    }
+    return board;
+}
+
+// 一组基准测试配置：算法 + 启发式函数 + 开放列表
+struct BenchmarkConfig
+{
+    std::string algorithm;
+    HeuristicType heuristic;
+    OpenListType openListType;
+};
+
+// 非交互的基准测试：用给定种子生成instanceCount个可解实例，
+// 对每个实例运行所有算法、启发式函数和开放列表组合，逐条写入CSV，最后打印各组合的平均值
+int runBenchmark(int instanceCount, unsigned int seed, const std::string &csvPath, size_t memoryBudget)
+{
+    std::vector<BenchmarkConfig> configs;
+    configs.push_back({"BFS", HeuristicType::MANHATTAN, OpenListType::BINARY_HEAP});
+    for (const std::string algorithm : {"A*", "Greedy"})
+    {
+        for (HeuristicType heuristic : ALL_HEURISTICS)
+        {
+            for (OpenListType openListType : ALL_OPEN_LISTS)
+            {
+                configs.push_back({algorithm, heuristic, openListType});
+            }
+        }
+    }
+
+    std::ofstream file;
+    if (csvPath != "-")
+    {
+        file.open(csvPath);
+        if (!file)
+        {
+            std::cerr << "无法打开输出文件：" << csvPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &csv = (csvPath == "-") ? std::cout : file;
+
+    csv << "instance,board,algorithm,heuristic,open_list,solved,solution_length,nodes_expanded,nodes_generated,"
+           "nodes_reopened,nodes_at_solution_f,peak_open,peak_bytes,ida_fallback_bound,time_ms"
+        << std::endl;
+    csv << std::setprecision(3) << std::fixed;
+
+    std::vector<AlgorithmPerformance> totals(configs.size());
+    std::vector<int> solvedCounts(configs.size(), 0);
+    std::mt19937 rng(seed);
+
+    for (int instance = 0; instance < instanceCount; ++instance)
+    {
+        std::vector<std::vector<int>> initialState = generateSolvableInstance(rng);
+        std::string boardKey;
+        for (const std::vector<int> &row : initialState)
+        {
+            for (int value : row)
+            {
+                boardKey += static_cast<char>('0' + value);
+            }
+        }
+
+        for (size_t c = 0; c < configs.size(); ++c)
+        {
+            const BenchmarkConfig &config = configs[c];
+            AlgorithmPerformance perf =
+                runAlgorithmWithPerformance(initialState, config.algorithm, config.heuristic, config.openListType, false,
+                                            memoryBudget).second;
+            bool informed = config.algorithm != "BFS";
+
+            csv << instance << ',' << boardKey << ',' << config.algorithm << ','
+                << (informed ? heuristicKey(config.heuristic) : "-") << ','
+                << (informed ? openListKey(config.openListType) : "-") << ','
+                << (perf.solved ? 1 : 0) << ',' << perf.solutionSteps << ','
+                << perf.nodesExplored << ',' << perf.nodesGenerated << ','
+                << perf.nodesReopened << ',' << perf.nodesAtSolutionF << ','
+                << perf.peakOpenSize << ',' << perf.peakBytes << ',' << perf.fallbackBound << ','
+                << perf.timeMs << '\n';
+
+            AlgorithmPerformance &total = totals[c];
+            total.nodesExplored += perf.nodesExplored;
+            total.peakOpenSize += perf.peakOpenSize;
+            total.peakBytes = std::max(total.peakBytes, perf.peakBytes);
+            total.timeMs += perf.timeMs;
+            if (perf.solved)
+            {
+                total.solutionSteps += perf.solutionSteps;
+                solvedCounts[c]++;
+            }
+        }
+    }
+    csv.flush();
+
+    // 汇总：各组合的平均扩展节点数、平均开放列表峰值、平均耗时和平均解长度
+    std::ostream &summary = (csvPath == "-") ? std::cerr : std::cout;
+    summary << std::setprecision(3) << std::fixed;
+    summary << "实例数：" << instanceCount << "，随机种子：" << seed
+            << "，内存预算：" << memoryBudget / 1024 << " KB" << std::endl;
+    summary << padDisplay("算法", 8) << padDisplay("启发式函数", 18) << padDisplay("开放列表", 16)
+            << padDisplay("求解数", 8) << padDisplay("平均扩展", 12) << padDisplay("平均开放峰值", 14)
+            << padDisplay("平均步数", 10) << "平均耗时(ms)" << std::endl;
+    for (size_t c = 0; c < configs.size(); ++c)
+    {
+        const BenchmarkConfig &config = configs[c];
+        bool informed = config.algorithm != "BFS";
+        double n = instanceCount > 0 ? instanceCount : 1;
+        double solved = solvedCounts[c] > 0 ? solvedCounts[c] : 1;
+        summary << padDisplay(config.algorithm, 8)
+                << padDisplay(informed ? heuristicKey(config.heuristic) : "-", 18)
+                << padDisplay(informed ? openListKey(config.openListType) : "-", 16)
+                << padDisplay(std::to_string(solvedCounts[c]), 8)
+                << padDisplay(std::to_string(static_cast<long long>(totals[c].nodesExplored / n)), 12)
+                << padDisplay(std::to_string(static_cast<long long>(totals[c].peakOpenSize / n)), 14)
+                << padDisplay(formatFixed(totals[c].solutionSteps / solved), 10)
+                << totals[c].timeMs / n << std::endl;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
 {
     // 设置控制台输出
     std::ios_base::sync_with_stdio(false);
     std::cout << std::setprecision(3) << std::fixed;
 
+    // 基准测试模式：EightPuzzle --bench [实例数] [随机种子] [CSV文件，"-"表示标准输出] [内存预算KB]
+    if (argc > 1 && std::string(argv[1]) == "--bench")
+    {
+        int instanceCount = argc > 2 ? std::atoi(argv[2]) : 100;
+        unsigned int seed = argc > 3 ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : 2025;
+        std::string csvPath = argc > 4 ? argv[4] : "bench.csv";
+        size_t memoryBudget = argc > 5 ? static_cast<size_t>(std::strtoul(argv[5], nullptr, 10)) * 1024
+                                       : EightPuzzleSolver::DEFAULT_MEMORY_BUDGET;
+        return runBenchmark(instanceCount, seed, csvPath, memoryBudget);
+    }
+
     std::cout << "八数码问题求解器" << std::endl;
     std::cout << "==================" << std::endl;
     std::cout << "1. 使用BFS算法" << std::endl;
     std::cout << "2. 使用A*算法" << std::endl;
     std::cout << "3. 使用贪心算法" << std::endl;
-    std::cout << "请选择算法(1-3): ";
+    std::cout << "4. 比较所有算法和启发式函数" << std::endl;
+    std::cout << "请选择算法(1-4): ";
 
     int algorithmChoice;
     std::cin >> algorithmChoice;
 
+    // A*和贪心算法需要选择启发式函数和开放列表
+    HeuristicType heuristic = HeuristicType::MANHATTAN;
+    OpenListType openListType = OpenListType::BUCKET_HIGH_G;
+    if (algorithmChoice == 2 || algorithmChoice == 3)
+    {
+        heuristic = chooseHeuristic();
+        openListType = chooseOpenList(algorithmChoice == 2 ? OpenListType::BUCKET_HIGH_G : OpenListType::BUCKET_LIFO);
+    }
+
     // 选择初始状态
     std::cout << "\n选择初始状态(1-6): ";
     int stateChoice;
@@ -335,10 +677,13 @@ int main()
         runAlgorithm(initialState, "BFS");
         break;
     case 2:
-        runAlgorithm(initialState, "A*");
+        runAlgorithm(initialState, "A*", heuristic, openListType);
         break;
     case 3:
-        runAlgorithm(initialState, "Greedy");
+        runAlgorithm(initialState, "Greedy", heuristic, openListType);
+        break;
+    case 4:
+        compareAllAlgorithms(initialState);
         break;
     default:
         std::cout << "无效的算法选择，使用默认BFS算法" << std::endl;
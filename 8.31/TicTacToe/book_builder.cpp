@@ -0,0 +1,100 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include <cstdlib>
+#include <cstring>
+#include "tictactoe.hpp"
+#include "mnk_engine.hpp"
+
+// 开局库生成器：对前若干步内的所有局面离线做深度搜索，把 局面哈希 -> 最佳着法/评估值 写成排序的二进制文件
+// 用法：book_builder tictactoe 步数 输出文件
+//       book_builder mnk 行数 列数 k 步数 每个局面毫秒数 输出文件
+// 井字棋的库对每个轮到X走的局面按规范朝向保存深度1..(空格数-1)的结果（覆盖全部空格的深度由完美对弈表处理），
+// tictactoe_v2/v3运行时自动读取当前目录下的tictactoe.book；m,n,k棋的库由 mnk_game --book 文件 使用
+
+// 井字棋：枚举走了不到plies步的所有未结束局面，对称的局面只算一次。
+// findBestMove总是替X（最大化一方）找着法，所以只收录轮到X走的局面
+void buildTicTacToe(TicTacToeState& state, int plies, std::unordered_set<uint64_t>& seen,
+                    std::vector<BookEntry>& entries) {
+    if (state.isTerminal() || __builtin_popcount(state.xMask | state.oMask) >= plies ||
+        !seen.insert(canonicalHash(state)).second) {
+        return;
+    }
+
+    uint64_t key = canonicalHash(state);
+    TicTacToeState canon = transformState(state, canonicalSymmetry(state));
+    int empties = __builtin_popcount(canon.emptyMask());
+    for (int depth = 1; depth < empties && state.currentPlayer == 'X'; depth++) {
+        auto [row, col] = searchBestMove(canon, depth, globalTranspositionTable());
+        int cell = row * 3 + col;
+        canon.play(cell);
+        int value = minimaxAlphaBeta(canon, depth - 1, std::numeric_limits<int>::min(),
+                                     std::numeric_limits<int>::max(), false);
+        canon.undo(cell);
+        entries.push_back(BookEntry{key, value, static_cast<int16_t>(cell), static_cast<int16_t>(depth)});
+    }
+
+    for (unsigned moves = state.emptyMask(); moves; moves &= moves - 1) {
+        int cell = lowestCell(moves);
+        state.play(cell);
+        buildTicTacToe(state, plies, seen, entries);
+        state.undo(cell);
+    }
+}
+
+// m,n,k棋：枚举走了不到plies步的局面（只走候选着法），每个局面用引擎搜索timeLimit毫秒
+void buildMnk(MnkBoard& board, int plies, int timeLimit, MnkEngine& engine, std::unordered_set<uint64_t>& seen,
+              std::vector<BookEntry>& entries) {
+    if (board.lastMoveWon() || board.isFull() || board.moveCount() >= plies || !seen.insert(board.hash()).second) {
+        return;
+    }
+
+    MnkSearchResult result = engine.search(board, timeLimit);
+    entries.push_back(BookEntry{board.hash(), result.value, static_cast<int16_t>(result.move),
+                                static_cast<int16_t>(result.depth)});
+    if (entries.size() % 100 == 0) {
+        std::cerr << entries.size() << " positions" << std::endl;
+    }
+
+    std::vector<int> moves;
+    board.candidateMoves(moves);
+    for (int m : moves) {
+        board.play(m);
+        buildMnk(board, plies, timeLimit, engine, seen, entries);
+        board.undo();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<BookEntry> entries;
+    std::unordered_set<uint64_t> seen;
+    std::string output;
+
+    if (argc == 4 && std::strcmp(argv[1], "tictactoe") == 0) {
+        TicTacToeState state;
+        buildTicTacToe(state, std::atoi(argv[2]), seen, entries);
+        output = argv[3];
+    } else if (argc == 8 && std::strcmp(argv[1], "mnk") == 0) {
+        try {
+            MnkBoard board(std::atoi(argv[2]), std::atoi(argv[3]), std::atoi(argv[4]));
+            MnkEngine engine;
+            buildMnk(board, std::atoi(argv[5]), std::atoi(argv[6]), engine, seen, entries);
+        } catch (const std::invalid_argument& e) {
+            std::cout << e.what() << std::endl;
+            return 1;
+        }
+        output = argv[7];
+    } else {
+        std::cout << "Usage: book_builder tictactoe plies output" << std::endl;
+        std::cout << "       book_builder mnk rows cols k plies ms output" << std::endl;
+        return 1;
+    }
+
+    if (!writeOpeningBook(output, entries)) {
+        std::cout << "Could not write " << output << std::endl;
+        return 1;
+    }
+    std::cout << seen.size() << " positions, " << entries.size() << " entries written to " << output << std::endl;
+    return 0;
+}
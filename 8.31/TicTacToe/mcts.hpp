@@ -0,0 +1,301 @@
+#ifndef MCTS_HPP
+#define MCTS_HPP
+
+#include <vector>
+#include <map>
+#include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <optional>
+#include <algorithm>
+
+// 蒙特卡洛树搜索（UCT），不依赖具体棋类。
+// 每种棋盘类型State需要特化 MctsGame<State>，提供以下静态函数：
+//   void legalMoves(const State&, std::vector<int>&)  树中展开的着法
+//   int  randomMove(const State&, uint64_t& rng)      随机模拟时的着法（只在对局未结束时调用）
+//   void play(State&, int move) / undo(State&, int move)
+//   int  toMove(const State&)                         轮到的玩家：0或1
+//   int  winner(const State&)                         -1未结束，0/1为获胜方，2为平局
+//   uint64_t key(const State&)                        局面标识，用于在两步之间复用搜索树
+template <class State>
+struct MctsGame;
+
+const double MCTS_EXPLORATION = 1.41421356; // UCT探索系数，取sqrt(2)
+
+// xorshift64随机数，随机模拟时每步都要调用，比<random>快得多
+inline uint64_t mctsRandom(uint64_t& rng) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng;
+}
+
+// 一次搜索的结果
+struct MctsResult {
+    int move;            // 访问次数最多的根着法，无子可下时为-1
+    double winRate;      // 该着法的平均收益（平局记0.5）
+    long long playouts;  // 本次搜索的模拟次数（所有线程之和）
+    size_t treeNodes;    // 搜索结束时各棵树的结点总数
+    double seconds;
+};
+
+// 根并行的MCTS：每个线程维护自己的一棵树，结束时按着法合并根结点各子结点的访问次数。
+// 下一次搜索的局面是上次根局面走一两步后得到的时，把对应子树移到数组开头继续使用
+template <class State>
+class MctsEngine {
+public:
+    explicit MctsEngine(int threads = 1, size_t maxNodes = 1 << 21)
+        : maxNodes(maxNodes), trees(std::max(1, threads)) {
+        for (size_t i = 0; i < trees.size(); i++) {
+            trees[i].rng = 0x9E3779B97F4A7C15ULL * (i + 1);
+        }
+    }
+
+    int threadCount() const { return static_cast<int>(trees.size()); }
+
+    // 丢弃所有树，下一次搜索从头开始
+    void reset() {
+        for (Tree& t : trees) {
+            t.nodes.clear();
+            t.root.reset();
+        }
+    }
+
+    // 搜索timeLimitMs毫秒，或者模拟maxPlayouts次，先到者为准；两者为0时分别表示不限。
+    // cancelled置位时提前结束；progress不为空时累加模拟次数，供界面显示
+    MctsResult search(const State& state, int timeLimitMs, long long maxPlayouts = 0,
+                      const std::atomic<bool>* cancelled = nullptr, std::atomic<long long>* progress = nullptr) {
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + std::chrono::milliseconds(std::max(timeLimitMs, 0));
+        std::atomic<long long> done{0};
+
+        auto work = [&](Tree& t) {
+            prepareRoot(t, state);
+            State board = state;
+            std::vector<int> path;
+            std::vector<int> moves;
+            long long local = 0;
+            while (true) {
+                if ((local & 63) == 0) {
+                    if ((timeLimitMs > 0 && std::chrono::steady_clock::now() >= deadline) ||
+                        (cancelled && cancelled->load(std::memory_order_relaxed))) {
+                        break;
+                    }
+                }
+                if (maxPlayouts > 0 && done.fetch_add(1, std::memory_order_relaxed) >= maxPlayouts) {
+                    break;
+                }
+                runPlayout(t, board, path, moves);
+                local++;
+                if (progress) {
+                    progress->fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            t.playouts = local;
+        };
+
+        std::vector<std::thread> helpers;
+        for (size_t i = 1; i < trees.size(); i++) {
+            helpers.emplace_back(work, std::ref(trees[i]));
+        }
+        work(trees[0]);
+        for (std::thread& th : helpers) {
+            th.join();
+        }
+
+        // 合并各棵树根结点的统计，选访问次数最多的着法
+        std::map<int, std::pair<long long, double>> merged;
+        MctsResult result{-1, 0.0, 0, 0, 0.0};
+        for (const Tree& t : trees) {
+            const Node& root = t.nodes[0];
+            for (int i = 0; i < root.childCount; i++) {
+                const Node& child = t.nodes[root.firstChild + i];
+                merged[child.move].first += child.visits;
+                merged[child.move].second += child.reward;
+            }
+            result.playouts += t.playouts;
+            result.treeNodes += t.nodes.size();
+        }
+        long long bestVisits = -1;
+        for (const auto& [move, stats] : merged) {
+            if (stats.first > bestVisits) {
+                bestVisits = stats.first;
+                result.move = move;
+                result.winRate = stats.first > 0 ? stats.second / stats.first : 0.0;
+            }
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+private:
+    typedef MctsGame<State> Game;
+
+    // 树结点存放在连续数组中，一个结点的所有子结点相邻，由firstChild和childCount给出
+    struct Node {
+        int move;          // 从父结点走到这里的着法
+        int firstChild;    // 未展开时为-1
+        int childCount;
+        int visits;
+        double reward;     // 走出move的一方的累计收益：赢1，平0.5，输0
+    };
+
+    struct Tree {
+        std::vector<Node> nodes;
+        std::optional<State> root;
+        uint64_t rng;
+        long long playouts = 0;
+    };
+
+    size_t maxNodes;
+    std::vector<Tree> trees;
+
+    // 把以keep为根的子树复制到新数组，子结点仍然保持相邻
+    static void reroot(Tree& t, int keep) {
+        std::vector<Node> out;
+        out.reserve(t.nodes.size());
+        out.push_back(t.nodes[keep]);
+        out[0].move = -1;
+        for (size_t i = 0; i < out.size(); i++) {
+            int first = out[i].firstChild;
+            if (first < 0) {
+                continue;
+            }
+            out[i].firstChild = static_cast<int>(out.size());
+            for (int c = 0; c < out[i].childCount; c++) {
+                out.push_back(t.nodes[first + c]);
+            }
+        }
+        t.nodes.swap(out);
+    }
+
+    // 在上一次的树里找state（根本身、一步或两步之后），找到就复用，否则新建只有根的树
+    void prepareRoot(Tree& t, const State& state) {
+        uint64_t target = Game::key(state);
+        if (t.root && !t.nodes.empty()) {
+            if (Game::key(*t.root) == target) {
+                return;
+            }
+            State s = *t.root;
+            const Node& root = t.nodes[0];
+            for (int i = 0; i < root.childCount; i++) {
+                int child = root.firstChild + i;
+                Game::play(s, t.nodes[child].move);
+                if (Game::key(s) == target) {
+                    Game::undo(s, t.nodes[child].move);
+                    reroot(t, child);
+                    t.root = state;
+                    return;
+                }
+                const Node& c = t.nodes[child];
+                for (int j = 0; j < c.childCount; j++) {
+                    int grandChild = c.firstChild + j;
+                    Game::play(s, t.nodes[grandChild].move);
+                    bool found = Game::key(s) == target;
+                    Game::undo(s, t.nodes[grandChild].move);
+                    if (found) {
+                        Game::undo(s, t.nodes[child].move);
+                        reroot(t, grandChild);
+                        t.root = state;
+                        return;
+                    }
+                }
+                Game::undo(s, t.nodes[child].move);
+            }
+        }
+        t.nodes.clear();
+        t.nodes.push_back(Node{-1, -1, 0, 0, 0.0});
+        t.root = state;
+    }
+
+    void expand(Tree& t, int index, const State& board, std::vector<int>& moves) {
+        Game::legalMoves(board, moves);
+        if (moves.empty() || t.nodes.size() + moves.size() > maxNodes) {
+            return;
+        }
+        t.nodes[index].firstChild = static_cast<int>(t.nodes.size());
+        t.nodes[index].childCount = static_cast<int>(moves.size());
+        for (int m : moves) {
+            t.nodes.push_back(Node{m, -1, 0, 0, 0.0});
+        }
+    }
+
+    // UCT选择：未访问过的子结点优先，否则取 平均收益 + c*sqrt(ln N / n) 最大者
+    int selectChild(Tree& t, int index) {
+        const Node& parent = t.nodes[index];
+        double logVisits = std::log(static_cast<double>(parent.visits));
+        int best = parent.firstChild;
+        double bestScore = -1.0;
+        for (int i = 0; i < parent.childCount; i++) {
+            const Node& child = t.nodes[parent.firstChild + i];
+            if (child.visits == 0) {
+                return parent.firstChild + i;
+            }
+            double score = child.reward / child.visits + MCTS_EXPLORATION * std::sqrt(logVisits / child.visits);
+            if (score > bestScore) {
+                bestScore = score;
+                best = parent.firstChild + i;
+            }
+        }
+        return best;
+    }
+
+    // 一次完整的选择-扩展-模拟-回传，board在调用前后都是根局面
+    void runPlayout(Tree& t, State& board, std::vector<int>& path, std::vector<int>& moves) {
+        int rootPlayer = Game::toMove(board);
+        path.clear();
+        path.push_back(0);
+
+        // 选择
+        int index = 0;
+        while (t.nodes[index].firstChild >= 0 && Game::winner(board) < 0) {
+            index = selectChild(t, index);
+            Game::play(board, t.nodes[index].move);
+            path.push_back(index);
+        }
+
+        // 扩展：访问过的叶结点展开全部着法，随机走进其中一个
+        if (Game::winner(board) < 0 && (t.nodes[index].visits > 0 || index == 0)) {
+            expand(t, index, board, moves);
+            const Node& leaf = t.nodes[index];
+            if (leaf.firstChild >= 0) {
+                index = leaf.firstChild + static_cast<int>(mctsRandom(t.rng) % leaf.childCount);
+                Game::play(board, t.nodes[index].move);
+                path.push_back(index);
+            }
+        }
+
+        // 模拟：双方随机落子直到终局
+        size_t treeMoves = path.size() - 1;
+        moves.clear();
+        int result;
+        while ((result = Game::winner(board)) < 0) {
+            int m = Game::randomMove(board, t.rng);
+            Game::play(board, m);
+            moves.push_back(m);
+        }
+        while (!moves.empty()) {
+            Game::undo(board, moves.back());
+            moves.pop_back();
+        }
+
+        // 回传：深度为d的结点的着法是根玩家走（d为奇数）或对手走（d为偶数）的
+        for (size_t d = 0; d < path.size(); d++) {
+            Node& n = t.nodes[path[d]];
+            n.visits++;
+            int mover = (d % 2 == 1) ? rootPlayer : 1 - rootPlayer;
+            if (result == 2) {
+                n.reward += 0.5;
+            } else if (result == mover) {
+                n.reward += 1.0;
+            }
+        }
+        for (size_t d = treeMoves; d > 0; d--) {
+            Game::undo(board, t.nodes[path[d]].move);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,913 @@
+#ifndef MNK_ENGINE_HPP
+#define MNK_ENGINE_HPP
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "mcts.hpp"
+#include "opening_book.hpp"
+
+// m,n,k棋类通用引擎：m行n列的棋盘上先连成k子者获胜（3,3,3即井字棋，15,15,5即五子棋）
+
+const int MNK_MAX_SIDE = 32; // 行数、列数上限，每条线用一个32位掩码
+const int MNK_MAX_K = 8;     // 连子数上限
+const int MNK_MAX_PLY = 128; // 搜索深度上限
+const int MNK_NEAR_RADIUS = 2; // 候选着法：距离已有棋子不超过该格数的空格
+
+// 胜负分数：获胜记为 MNK_WIN_SCORE - 步数，越早获胜分数越高
+const int MNK_WIN_SCORE = 1000000;
+const int MNK_WIN_BOUND = MNK_WIN_SCORE - 1000;
+
+// 4个方向：横、竖、主对角线（右下）、副对角线（左下）
+const int MNK_DR[4] = {0, 1, 1, 1};
+const int MNK_DC[4] = {1, 0, 1, -1};
+
+// m,n,k棋盘：玩家0（X）先手，玩家1（O）后手
+class MnkBoard {
+public:
+    int rows;
+    int cols;
+    int k;
+
+    MnkBoard(int rows, int cols, int k) : rows(rows), cols(cols), k(k), player(0), xScore(0) {
+        if (rows < 1 || cols < 1 || rows > MNK_MAX_SIDE || cols > MNK_MAX_SIDE) {
+            throw std::invalid_argument("board size must be 1.." + std::to_string(MNK_MAX_SIDE));
+        }
+        if (k < 2 || k > MNK_MAX_K || k > std::max(rows, cols)) {
+            throw std::invalid_argument("k must be 2.." + std::to_string(MNK_MAX_K) + " and fit on the board");
+        }
+
+        cells.assign(rows * cols, -1);
+        nearCount.assign(rows * cols, 0);
+        for (int p = 0; p < 2; p++) {
+            lineBits[p][0].assign(rows, 0);
+            lineBits[p][1].assign(cols, 0);
+            lineBits[p][2].assign(rows + cols - 1, 0);
+            lineBits[p][3].assign(rows + cols - 1, 0);
+        }
+        buildWindows();
+        buildZobrist();
+        hashValue = 0;
+    }
+
+    int cellCount() const { return rows * cols; }
+    int cellOf(int row, int col) const { return row * cols + col; }
+    int currentPlayer() const { return player; }
+    int moveCount() const { return static_cast<int>(history.size()); }
+    int lastMove() const { return history.empty() ? -1 : history.back(); }
+    bool isFull() const { return moveCount() == cellCount(); }
+    uint64_t hash() const { return hashValue; }
+
+    // 格子上的棋子：-1为空，0为X，1为O
+    int stoneAt(int cell) const { return cells[cell]; }
+    bool isEmpty(int cell) const { return cells[cell] < 0; }
+
+    // 上一步是否连成了k子
+    bool lastMoveWon() const { return lastWon; }
+
+    // 当前玩家在cell落子是否立即获胜（不修改棋盘）
+    bool isWinningMove(int cell, int p) const {
+        int r = cell / cols, c = cell % cols;
+        for (int dir = 0; dir < 4; dir++) {
+            uint32_t line = lineBits[p][dir][lineIndex(dir, r, c)] | (1u << bitIndex(dir, r, c));
+            if (hasRun(line)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 当前玩家落子并切换玩家，调用前须保证格子为空
+    void play(int cell) {
+        int r = cell / cols, c = cell % cols;
+
+        cells[cell] = static_cast<signed char>(player);
+        for (int dir = 0; dir < 4; dir++) {
+            lineBits[player][dir][lineIndex(dir, r, c)] |= 1u << bitIndex(dir, r, c);
+        }
+        updateWindows(cell, player, +1);
+        updateNear(r, c, +1);
+        hashValue ^= zobrist[player][cell];
+
+        wonStack.push_back(lastWon);
+        lastWon = isWinningMove(cell, player);
+        history.push_back(cell);
+        player ^= 1;
+    }
+
+    // 撤销最后一步
+    void undo() {
+        int cell = history.back();
+        int r = cell / cols, c = cell % cols;
+
+        history.pop_back();
+        player ^= 1;
+        lastWon = wonStack.back();
+        wonStack.pop_back();
+
+        hashValue ^= zobrist[player][cell];
+        updateNear(r, c, -1);
+        updateWindows(cell, player, -1);
+        for (int dir = 0; dir < 4; dir++) {
+            lineBits[player][dir][lineIndex(dir, r, c)] &= ~(1u << bitIndex(dir, r, c));
+        }
+        cells[cell] = -1;
+    }
+
+    // 以当前玩家视角的威胁评分：每个长度为k的窗口只含一方棋子时按子数计分。
+    // 多个窗口的得分相加可能超过MNK_WIN_BOUND，截断到胜负分数以下，免得被当成杀棋分数
+    int evaluate() const {
+        int score = std::clamp(xScore, -(MNK_WIN_BOUND - 1), MNK_WIN_BOUND - 1);
+        return player == 0 ? score : -score;
+    }
+
+    // 玩家p的成五点：p只差一子连成k的窗口中剩下的空格（已去重）
+    void winningPoints(int p, std::vector<int>& points) const {
+        points.clear();
+        for (int w : threatWindows[p][0]) {
+            for (int i = 0; i < k; i++) {
+                int cell = windowCell(w, i);
+                if (cells[cell] < 0) {
+                    points.push_back(cell);
+                    break;
+                }
+            }
+        }
+        sortUnique(points);
+    }
+
+    // 玩家p的冲四点：落子后窗口只差一子的空格，即差两子的窗口中的两个空格（已去重）
+    void fourMoves(int p, std::vector<int>& moves) const {
+        moves.clear();
+        for (int w : threatWindows[p][1]) {
+            for (int i = 0; i < k; i++) {
+                int cell = windowCell(w, i);
+                if (cells[cell] < 0) {
+                    moves.push_back(cell);
+                }
+            }
+        }
+        sortUnique(moves);
+    }
+
+    // 候选着法：靠近已有棋子的空格；空棋盘只下中心
+    void candidateMoves(std::vector<int>& moves) const {
+        moves.clear();
+        if (history.empty()) {
+            moves.push_back(cellOf(rows / 2, cols / 2));
+            return;
+        }
+        for (int cell = 0; cell < cellCount(); cell++) {
+            if (cells[cell] < 0 && nearCount[cell] > 0) {
+                moves.push_back(cell);
+            }
+        }
+    }
+
+private:
+    std::vector<signed char> cells;
+    std::vector<uint32_t> lineBits[2][4]; // [玩家][方向][线]：该线上的棋子，第i位对应线上第i个格子
+    std::vector<int> nearCount;           // 周围MNK_NEAR_RADIUS格内的棋子数
+    std::vector<int> history;
+    std::vector<char> wonStack;
+    int player;
+    bool lastWon = false;
+
+    // 威胁评分的增量维护：每个窗口记录双方子数，评分是所有窗口得分之和
+    std::vector<int> windowStart;   // cell的窗口列表为 windowList[windowStart[cell] .. windowStart[cell+1])
+    std::vector<int> windowList;
+    std::vector<unsigned char> windowCount[2];
+    std::vector<int> windowFirst;   // 窗口的第一个格子
+    std::vector<int> windowStep;    // 窗口中相邻格子的编号差
+    int weight[MNK_MAX_K + 1];
+    int xScore;                     // X视角的总评分
+
+    // 威胁窗口表：threatWindows[p][0]是只有p的棋子且差一子连成k的窗口，[p][1]是差两子的窗口。
+    // 一个窗口同一时刻最多属于其中一个表，threatSlot记录它在表中的位置，增删都是O(1)
+    std::vector<int> threatWindows[2][2];
+    std::vector<int> threatSlot;
+
+    std::vector<uint64_t> zobrist[2];
+    uint64_t hashValue;
+
+    // 格子(r, c)在方向dir上所在的线及在线上的位置
+    int lineIndex(int dir, int r, int c) const {
+        switch (dir) {
+        case 0: return r;
+        case 1: return c;
+        case 2: return r - c + cols - 1;
+        default: return r + c;
+        }
+    }
+
+    int bitIndex(int dir, int r, int c) const {
+        return dir == 0 ? c : r;
+    }
+
+    // 掩码中是否有连续k个1
+    bool hasRun(uint32_t line) const {
+        for (int i = 1; i < k && line; i++) {
+            line &= line >> 1;
+        }
+        return line != 0;
+    }
+
+    int windowValue(int w) const {
+        int x = windowCount[0][w], o = windowCount[1][w];
+        if (x > 0 && o > 0) {
+            return 0; // 双方都有子的窗口已经不可能连成k子
+        }
+        return x > 0 ? weight[x] : -weight[o];
+    }
+
+    int windowCell(int w, int i) const {
+        return windowFirst[w] + i * windowStep[w];
+    }
+
+    static void sortUnique(std::vector<int>& v) {
+        std::sort(v.begin(), v.end());
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+    }
+
+    // 窗口所属的威胁表：-1表示不在任何表中，否则为 玩家*2 + (0差一子 / 1差两子)
+    int threatClass(int w) const {
+        int x = windowCount[0][w], o = windowCount[1][w];
+        if (x > 0 && o > 0) {
+            return -1;
+        }
+        int p = x > 0 ? 0 : 1;
+        int n = x > 0 ? x : o;
+        if (n == k - 1) {
+            return p * 2;
+        }
+        if (n == k - 2 && n > 0) {
+            return p * 2 + 1;
+        }
+        return -1;
+    }
+
+    void moveThreatWindow(int w, int from, int to) {
+        if (from == to) {
+            return;
+        }
+        if (from >= 0) {
+            std::vector<int>& list = threatWindows[from / 2][from % 2];
+            int slot = threatSlot[w];
+            list[slot] = list.back();
+            threatSlot[list[slot]] = slot;
+            list.pop_back();
+        }
+        if (to >= 0) {
+            std::vector<int>& list = threatWindows[to / 2][to % 2];
+            threatSlot[w] = static_cast<int>(list.size());
+            list.push_back(w);
+        }
+    }
+
+    void updateWindows(int cell, int p, int delta) {
+        for (int i = windowStart[cell]; i < windowStart[cell + 1]; i++) {
+            int w = windowList[i];
+            int before = threatClass(w);
+            xScore -= windowValue(w);
+            windowCount[p][w] = static_cast<unsigned char>(windowCount[p][w] + delta);
+            xScore += windowValue(w);
+            moveThreatWindow(w, before, threatClass(w));
+        }
+    }
+
+    void updateNear(int r, int c, int delta) {
+        for (int dr = -MNK_NEAR_RADIUS; dr <= MNK_NEAR_RADIUS; dr++) {
+            for (int dc = -MNK_NEAR_RADIUS; dc <= MNK_NEAR_RADIUS; dc++) {
+                int nr = r + dr, nc = c + dc;
+                if (nr >= 0 && nr < rows && nc >= 0 && nc < cols) {
+                    nearCount[nr * cols + nc] += delta;
+                }
+            }
+        }
+    }
+
+    // 枚举所有长度为k的窗口，记录每个格子属于哪些窗口
+    void buildWindows() {
+        std::vector<std::vector<int>> perCell(rows * cols);
+        int nWindows = 0;
+
+        for (int dir = 0; dir < 4; dir++) {
+            for (int r = 0; r < rows; r++) {
+                for (int c = 0; c < cols; c++) {
+                    int er = r + (k - 1) * MNK_DR[dir], ec = c + (k - 1) * MNK_DC[dir];
+                    if (er < 0 || er >= rows || ec < 0 || ec >= cols) {
+                        continue;
+                    }
+                    for (int i = 0; i < k; i++) {
+                        perCell[(r + i * MNK_DR[dir]) * cols + c + i * MNK_DC[dir]].push_back(nWindows);
+                    }
+                    windowFirst.push_back(r * cols + c);
+                    windowStep.push_back(MNK_DR[dir] * cols + MNK_DC[dir]);
+                    nWindows++;
+                }
+            }
+        }
+
+        windowStart.assign(rows * cols + 1, 0);
+        windowList.clear();
+        for (int cell = 0; cell < rows * cols; cell++) {
+            windowStart[cell] = static_cast<int>(windowList.size());
+            windowList.insert(windowList.end(), perCell[cell].begin(), perCell[cell].end());
+        }
+        windowStart[rows * cols] = static_cast<int>(windowList.size());
+        windowCount[0].assign(nWindows, 0);
+        windowCount[1].assign(nWindows, 0);
+        threatSlot.assign(nWindows, -1);
+
+        // 子数每多一个，窗口得分乘8
+        weight[0] = 0;
+        for (int i = 1; i <= k; i++) {
+            weight[i] = 1 << (3 * (i - 1));
+        }
+    }
+
+    void buildZobrist() {
+        uint64_t seed = 0x9E3779B97F4A7C15ULL ^ (static_cast<uint64_t>(rows) << 32) ^ (cols << 16) ^ k;
+        for (int p = 0; p < 2; p++) {
+            zobrist[p].resize(rows * cols);
+            for (int cell = 0; cell < rows * cols; cell++) {
+                uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                zobrist[p][cell] = z ^ (z >> 31);
+            }
+        }
+    }
+};
+
+const int MNK_VCF_DEPTH = 16;          // VCF最多连续冲四的次数（攻方着法数）
+const long long MNK_VCF_NODES = 20000;  // 单次VCF搜索的结点上限，保证预检只占很少的时间
+
+// 连续冲四取胜（VCF）搜索：攻方每一步都必须形成成五点，守方只能堵在该点上。
+// 只看这些强制着法，成五点和冲四点直接从棋盘增量维护的威胁窗口表中取，
+// 所以十几步以上的强制胜也只需要很少的结点
+class MnkThreatSearch {
+public:
+    // 当前玩家能否靠连续冲四取胜：能则返回到获胜为止的步数（双方合计），move为第一步；否则返回0
+    int findWin(MnkBoard& board, int& move, int maxDepth = MNK_VCF_DEPTH, long long maxNodes = MNK_VCF_NODES) {
+        nodes = 0;
+        nodeLimit = maxNodes;
+        failed.clear();
+        return vcf(board, maxDepth, move);
+    }
+
+    long long nodeCount() const { return nodes; }
+
+private:
+    long long nodes = 0;
+    long long nodeLimit = 0;
+    std::unordered_map<uint64_t, int> failed; // 局面 -> 已证明在该剩余深度内没有VCF
+
+    int vcf(MnkBoard& board, int depth, int& move) {
+        nodes++;
+        int me = board.currentPlayer(), opp = me ^ 1;
+
+        std::vector<int> points;
+        board.winningPoints(me, points);
+        if (!points.empty()) {
+            move = points[0];
+            return 1;
+        }
+        if (depth <= 0 || nodes >= nodeLimit) {
+            return 0;
+        }
+        auto it = failed.find(board.hash());
+        if (it != failed.end() && it->second >= depth) {
+            return 0;
+        }
+
+        // 对方已有成五点时，只能在那里冲四（堵住的同时形成自己的成五点）
+        std::vector<int> oppPoints;
+        board.winningPoints(opp, oppPoints);
+        std::vector<int> candidates;
+        if (oppPoints.size() <= 1) {
+            board.fourMoves(me, candidates);
+            if (oppPoints.size() == 1) {
+                bool blocks = std::find(candidates.begin(), candidates.end(), oppPoints[0]) != candidates.end();
+                candidates.assign(blocks ? 1 : 0, oppPoints[0]);
+            }
+        }
+
+        std::vector<int> threats;
+        for (int m : candidates) {
+            board.play(m);
+            int plies = 0;
+            board.winningPoints(opp, oppPoints);
+            if (oppPoints.empty()) {
+                board.winningPoints(me, threats);
+                if (threats.size() >= 2) {
+                    plies = 3; // 双四：对方只能堵一个
+                } else if (threats.size() == 1) {
+                    board.play(threats[0]);
+                    int next;
+                    int sub = vcf(board, depth - 1, next);
+                    board.undo();
+                    if (sub > 0) {
+                        plies = sub + 2;
+                    }
+                }
+            }
+            board.undo();
+            if (plies > 0) {
+                move = m;
+                return plies;
+            }
+        }
+
+        failed[board.hash()] = depth;
+        return 0;
+    }
+};
+
+// 一次搜索的结果
+struct MnkSearchResult {
+    int move;          // 最佳着法（格子编号），无子可下时为-1
+    int value;         // 当前玩家视角的评分
+    int depth;         // 完成的迭代深度
+    long long nodes;   // 搜索的结点数（所有线程之和）
+    double seconds;
+    bool timedOut;     // 是否因为时间用完而停止
+    bool threatWin;    // 由VCF预检直接找到的强制胜
+    bool fromBook;     // 着法取自开局库
+};
+
+// 渴望窗口的初始半宽，失败的一侧每次放大4倍
+const int MNK_ASPIRATION_WINDOW = 64;
+
+// 迭代加深的主变例搜索（PVS，负极大值形式），带置换表、杀手着法和历史启发
+// 根结点按Young Brothers Wait并行：第一个着法单线程搜完定下alpha后，其余着法分给各线程，
+// 线程间共享置换表和原子alpha
+class MnkEngine {
+public:
+    explicit MnkEngine(size_t ttSize = 1 << 20, int threads = 1) : threads(std::max(1, threads)) {
+        size_t capacity = 1;
+        while (capacity < ttSize) {
+            capacity <<= 1;
+        }
+        table.reset(new Slot[capacity]);
+        tableMask = capacity - 1;
+        clear();
+    }
+
+    void setThreads(int n) { threads = std::max(1, n); }
+
+    // 开局库（键为MnkBoard::hash()），搜索前先查；传nullptr不用开局库
+    void setBook(const OpeningBook* b) { book = b; }
+    int threadCount() const { return threads; }
+
+    // 清空置换表
+    void clear() {
+        uint64_t empty = packEntry(0, -1, -1, EXACT);
+        for (size_t i = 0; i <= tableMask; i++) {
+            table[i].check.store(empty, std::memory_order_relaxed);
+            table[i].data.store(empty, std::memory_order_relaxed);
+        }
+    }
+
+    // 在timeLimitMs毫秒内搜索，最多maxDepth层；返回最后一次完成的迭代的结果
+    MnkSearchResult search(MnkBoard& board, int timeLimitMs, int maxDepth = MNK_MAX_PLY) {
+        auto start = std::chrono::steady_clock::now();
+        deadline = start + std::chrono::milliseconds(timeLimitMs);
+        stopped = false;
+        maxDepth = std::min(maxDepth, MNK_MAX_PLY - 1);
+
+        // 每个线程在自己的棋盘副本上搜索，杀手着法和历史表也各自独立
+        workers.clear();
+        workers.reserve(threads);
+        for (int i = 0; i < threads; i++) {
+            workers.emplace_back(board);
+        }
+
+        MnkSearchResult result{-1, 0, 0, 0, 0.0, false, false, false};
+
+        // 开局库中有这个局面时直接返回库中的着法
+        BookEntry entry;
+        if (book && book->probe(board.hash(), -1, entry) && entry.move >= 0 && entry.move < board.cellCount() &&
+            board.isEmpty(entry.move)) {
+            result.move = entry.move;
+            result.value = entry.value;
+            result.depth = entry.depth;
+            result.fromBook = true;
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return result;
+        }
+
+        // 预检：能连续冲四取胜时不必再做全宽搜索
+        int vcfMove;
+        int vcfPlies = threatSearch.findWin(board, vcfMove);
+        if (vcfPlies > 0) {
+            result.move = vcfMove;
+            result.value = MNK_WIN_SCORE - vcfPlies;
+            result.depth = vcfPlies;
+            result.nodes = threatSearch.nodeCount();
+            result.threatWin = true;
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return result;
+        }
+
+        std::vector<int> rootMoves;
+        board.candidateMoves(rootMoves);
+        if (!rootMoves.empty()) {
+            result.move = rootMoves[0];
+        }
+
+        int bestMove = -1;
+        for (int depth = 1; depth <= maxDepth && !rootMoves.empty(); depth++) {
+            // 上一轮的值不是胜负分数时，先在它附近的窗口里搜索，失败再放宽
+            int delta = MNK_ASPIRATION_WINDOW;
+            int alpha = -MNK_WIN_SCORE - 1, beta = MNK_WIN_SCORE + 1;
+            if (depth > 1 && result.value > -MNK_WIN_BOUND && result.value < MNK_WIN_BOUND) {
+                alpha = result.value - delta;
+                beta = result.value + delta;
+            }
+
+            int value;
+            int move = bestMove;
+            while (true) {
+                value = searchRoot(rootMoves, depth, alpha, beta, move);
+                if (stopped) {
+                    break;
+                }
+                if (value <= alpha && alpha > -MNK_WIN_SCORE - 1) {
+                    delta *= 4;
+                    alpha = std::max(value - delta, -MNK_WIN_SCORE - 1);
+                    move = bestMove;
+                } else if (value >= beta && beta < MNK_WIN_SCORE + 1) {
+                    delta *= 4;
+                    beta = std::min(value + delta, MNK_WIN_SCORE + 1);
+                } else {
+                    break;
+                }
+            }
+            if (stopped) {
+                break;
+            }
+            bestMove = move;
+            result.move = bestMove;
+            result.value = value;
+            result.depth = depth;
+
+            // 已经找到必胜/必败，或者空格都搜完了，不必再加深
+            if (value >= MNK_WIN_BOUND || value <= -MNK_WIN_BOUND ||
+                depth >= board.cellCount() - board.moveCount()) {
+                break;
+            }
+        }
+
+        result.nodes = threatSearch.nodeCount();
+        for (const Worker& w : workers) {
+            result.nodes += w.nodes;
+        }
+        result.timedOut = stopped;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+private:
+    enum Bound : unsigned char { EXACT, LOWER, UPPER };
+
+    struct Entry {
+        int value;
+        int move;
+        int depth;
+        Bound bound;
+    };
+
+    // 置换表槽位：data是打包后的表项，check = key ^ data。
+    // 多个线程同时读写时，读到的两个字对不上就当作未命中，不需要加锁
+    struct Slot {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    // 每个搜索线程的私有状态
+    struct Worker {
+        MnkBoard board;
+        int killers[MNK_MAX_PLY][2];
+        std::vector<int> history;   // [玩家*格子数 + 格子]：产生剪枝的次数按深度加权累计
+        long long nodes = 0;
+
+        explicit Worker(const MnkBoard& b) : board(b), history(2 * b.cellCount(), 0) {
+            for (auto& k : killers) {
+                k[0] = k[1] = -1;
+            }
+        }
+    };
+
+    std::unique_ptr<Slot[]> table;
+    size_t tableMask;
+    int threads;
+    std::vector<Worker> workers;
+    MnkThreatSearch threatSearch;
+    const OpeningBook* book = nullptr;
+    std::atomic<bool> stopped{false};
+    std::chrono::steady_clock::time_point deadline;
+
+    static uint64_t packEntry(int value, int move, int depth, Bound bound) {
+        return static_cast<uint32_t>(value) |
+               static_cast<uint64_t>(static_cast<uint16_t>(move)) << 32 |
+               static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 48 |
+               static_cast<uint64_t>(bound) << 56;
+    }
+
+    bool probeEntry(uint64_t key, Entry& e) const {
+        const Slot& s = table[key & tableMask];
+        uint64_t data = s.data.load(std::memory_order_relaxed);
+        if ((s.check.load(std::memory_order_relaxed) ^ data) != key) {
+            return false;
+        }
+        e.value = static_cast<int32_t>(static_cast<uint32_t>(data));
+        e.move = static_cast<int16_t>(static_cast<uint16_t>(data >> 32));
+        e.depth = static_cast<int8_t>(static_cast<uint8_t>(data >> 48));
+        e.bound = static_cast<Bound>(data >> 56);
+        return true;
+    }
+
+    void storeEntry(uint64_t key, int value, int move, int depth, Bound bound) {
+        Slot& s = table[key & tableMask];
+        uint64_t old = s.data.load(std::memory_order_relaxed);
+        uint64_t oldKey = s.check.load(std::memory_order_relaxed) ^ old;
+        if (oldKey != key && static_cast<int8_t>(static_cast<uint8_t>(old >> 48)) > depth) {
+            return;
+        }
+        uint64_t data = packEntry(value, move, depth, bound);
+        s.data.store(data, std::memory_order_relaxed);
+        s.check.store(key ^ data, std::memory_order_relaxed);
+    }
+
+    int probeMove(uint64_t key) const {
+        Entry e;
+        return probeEntry(key, e) ? e.move : -1;
+    }
+
+    // 必胜/必败分数在置换表中按“距当前结点的步数”保存，取出时再换算回距根结点的步数
+    static int toTable(int value, int ply) {
+        if (value >= MNK_WIN_BOUND) return value + ply;
+        if (value <= -MNK_WIN_BOUND) return value - ply;
+        return value;
+    }
+
+    static int fromTable(int value, int ply) {
+        if (value >= MNK_WIN_BOUND) return value - ply;
+        if (value <= -MNK_WIN_BOUND) return value + ply;
+        return value;
+    }
+
+    bool timeUp(Worker& w) {
+        if ((++w.nodes & 1023) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            stopped = true;
+        }
+        return stopped.load(std::memory_order_relaxed);
+    }
+
+    // 着法排序：置换表着法 > 杀手着法 > 历史得分
+    void orderMoves(const Worker& w, std::vector<int>& moves, int ttMove, int ply) {
+        const int* hist = &w.history[w.board.currentPlayer() * w.board.cellCount()];
+        std::vector<std::pair<int, int>> scored;
+        scored.reserve(moves.size());
+        for (int m : moves) {
+            int score = hist[m];
+            if (m == ttMove) {
+                score = std::numeric_limits<int>::max();
+            } else if (m == w.killers[ply][0]) {
+                score = std::numeric_limits<int>::max() - 1;
+            } else if (m == w.killers[ply][1]) {
+                score = std::numeric_limits<int>::max() - 2;
+            }
+            scored.push_back(std::make_pair(-score, m));
+        }
+        std::stable_sort(scored.begin(), scored.end());
+        for (size_t i = 0; i < moves.size(); i++) {
+            moves[i] = scored[i].second;
+        }
+    }
+
+    void recordCutoff(Worker& w, int move, int depth, int ply) {
+        if (w.killers[ply][0] != move) {
+            w.killers[ply][1] = w.killers[ply][0];
+            w.killers[ply][0] = move;
+        }
+        w.history[w.board.currentPlayer() * w.board.cellCount() + move] += depth * depth;
+    }
+
+    // 在窗口(alpha, beta)内搜索根结点的一个着法
+    int searchRootMove(Worker& w, int m, int depth, int alpha, int beta) {
+        if (w.board.isWinningMove(m, w.board.currentPlayer())) {
+            return MNK_WIN_SCORE - 1;
+        }
+        w.board.play(m);
+        int v = -negamax(w, depth - 1, -beta, -alpha, 1);
+        w.board.undo();
+        return v;
+    }
+
+    // 根结点搜索，bestMove传入上一轮的最佳着法（排在最前），传出本轮的最佳着法
+    // 返回值不超出(alpha, beta)时是准确值，否则只是上界/下界
+    int searchRoot(std::vector<int>& rootMoves, int depth, int alpha, int beta, int& bestMove) {
+        Worker& main = workers[0];
+        uint64_t key = main.board.hash();
+        int originalAlpha = alpha;
+
+        orderMoves(main, rootMoves, bestMove >= 0 ? bestMove : probeMove(key), 0);
+
+        // 长兄：第一个着法用完整窗口单线程搜索
+        int bestValue = searchRootMove(main, rootMoves[0], depth, alpha, beta);
+        bestMove = rootMoves[0];
+        if (stopped) {
+            return bestValue;
+        }
+
+        // 其余着法：各线程轮流领取，先用以共享alpha为界的零窗口试探，超过alpha再用完整窗口重搜
+        if (bestValue < beta && rootMoves.size() > 1) {
+            std::atomic<int> sharedAlpha{std::max(alpha, bestValue)};
+            std::atomic<size_t> next{1};
+            std::mutex bestLock;
+
+            auto work = [&](Worker& w) {
+                while (!stopped) {
+                    size_t i = next.fetch_add(1);
+                    int a = sharedAlpha.load();
+                    if (i >= rootMoves.size() || a >= beta) {
+                        break;
+                    }
+                    int m = rootMoves[i];
+                    int v = searchRootMove(w, m, depth, a, a + 1);
+                    if (v > a && v < beta && !stopped) {
+                        v = searchRootMove(w, m, depth, a, beta);
+                    }
+                    if (stopped) {
+                        break;
+                    }
+
+                    std::lock_guard<std::mutex> guard(bestLock);
+                    if (v > bestValue) {
+                        bestValue = v;
+                        bestMove = m;
+                    }
+                    if (v > sharedAlpha.load()) {
+                        sharedAlpha.store(v);
+                    }
+                }
+            };
+
+            std::vector<std::thread> helpers;
+            for (int t = 1; t < threads; t++) {
+                helpers.emplace_back(work, std::ref(workers[t]));
+            }
+            work(main);
+            for (std::thread& t : helpers) {
+                t.join();
+            }
+            if (stopped) {
+                return bestValue;
+            }
+        }
+
+        Bound bound = EXACT;
+        if (bestValue <= originalAlpha) {
+            bound = UPPER;
+        } else if (bestValue >= beta) {
+            bound = LOWER;
+        }
+        storeEntry(key, toTable(bestValue, 0), bestMove, depth, bound);
+        return bestValue;
+    }
+
+    int negamax(Worker& w, int depth, int alpha, int beta, int ply) {
+        MnkBoard& board = w.board;
+        if (timeUp(w)) {
+            return 0;
+        }
+        if (board.isFull()) {
+            return 0;
+        }
+
+        std::vector<int> moves;
+        board.candidateMoves(moves);
+
+        // 有一步就能连成k子时直接获胜
+        int me = board.currentPlayer();
+        for (int m : moves) {
+            if (board.isWinningMove(m, me)) {
+                return MNK_WIN_SCORE - ply - 1;
+            }
+        }
+        if (depth <= 0 || ply >= MNK_MAX_PLY - 1) {
+            return board.evaluate();
+        }
+
+        int ttMove = -1;
+        Entry e;
+        if (probeEntry(board.hash(), e)) {
+            ttMove = e.move;
+            if (e.depth >= depth) {
+                int v = fromTable(e.value, ply);
+                if (e.bound == EXACT) {
+                    return v;
+                } else if (e.bound == LOWER) {
+                    alpha = std::max(alpha, v);
+                } else {
+                    beta = std::min(beta, v);
+                }
+                if (alpha >= beta) {
+                    return v;
+                }
+            }
+        }
+
+        orderMoves(w, moves, ttMove, ply);
+
+        int originalAlpha = alpha;
+        int bestValue = -MNK_WIN_SCORE - 1;
+        int bestMove = moves.empty() ? -1 : moves[0];
+        for (size_t i = 0; i < moves.size(); i++) {
+            int m = moves[i];
+            board.play(m);
+            int v;
+            if (i == 0) {
+                v = -negamax(w, depth - 1, -beta, -alpha, ply + 1);
+            } else {
+                // 主变例搜索：后面的着法先用零窗口证明不比alpha好，失败了再用完整窗口重搜
+                v = -negamax(w, depth - 1, -alpha - 1, -alpha, ply + 1);
+                if (v > alpha && v < beta) {
+                    v = -negamax(w, depth - 1, -beta, -alpha, ply + 1);
+                }
+            }
+            board.undo();
+            if (stopped) {
+                return 0;
+            }
+
+            if (v > bestValue) {
+                bestValue = v;
+                bestMove = m;
+            }
+            alpha = std::max(alpha, v);
+            if (alpha >= beta) {
+                recordCutoff(w, m, depth, ply);
+                break; // 剪枝
+            }
+        }
+
+        Bound bound = EXACT;
+        if (bestValue <= originalAlpha) {
+            bound = UPPER;
+        } else if (bestValue >= beta) {
+            bound = LOWER;
+        }
+        storeEntry(board.hash(), toTable(bestValue, ply), bestMove, depth, bound);
+        return bestValue;
+    }
+};
+
+// m,n,k棋接入MCTS：树中只展开靠近已有棋子的候选着法，随机模拟时可以下在任意空格
+template <>
+struct MctsGame<MnkBoard> {
+    static void legalMoves(const MnkBoard& b, std::vector<int>& moves) { b.candidateMoves(moves); }
+
+    // 先随机试几个格子，棋盘较满时再从随机位置开始顺序找空格
+    static int randomMove(const MnkBoard& b, uint64_t& rng) {
+        int n = b.cellCount();
+        for (int tries = 0; tries < 8; tries++) {
+            int cell = static_cast<int>(mctsRandom(rng) % n);
+            if (b.isEmpty(cell)) {
+                return cell;
+            }
+        }
+        int start = static_cast<int>(rng % n);
+        for (int i = 0; i < n; i++) {
+            int cell = (start + i) % n;
+            if (b.isEmpty(cell)) {
+                return cell;
+            }
+        }
+        return -1;
+    }
+
+    static void play(MnkBoard& b, int move) { b.play(move); }
+    static void undo(MnkBoard& b, int) { b.undo(); }
+    static int toMove(const MnkBoard& b) { return b.currentPlayer(); }
+
+    static int winner(const MnkBoard& b) {
+        if (b.lastMoveWon()) return b.currentPlayer() ^ 1;
+        return b.isFull() ? 2 : -1;
+    }
+
+    static uint64_t key(const MnkBoard& b) { return b.hash() ^ static_cast<uint64_t>(b.moveCount()); }
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <thread>
+#include "mnk_engine.hpp"
+
+// m,n,k棋命令行对战：AI执X先手，玩家执O；--selfplay 时双方都由AI下
+// 用法：mnk_game [--selfplay] [--mcts] [--threads N] [--book 文件] [--bench 深度] [行数 列数 k] [每步毫秒数]，默认15 15 5 1000
+// --book 指定book_builder生成的开局库，库中有的局面直接落子
+// --mcts 时AI改用蒙特卡洛树搜索（每个线程一棵树），否则用迭代加深的Alpha-Beta
+// --bench 不对战，而是在固定局面上按不同线程数搜索到指定深度，比较加速比和搜索开销
+
+// 打印棋盘，最后一步用小写字母标出
+void printBoard(const MnkBoard& board) {
+    std::cout << "   ";
+    for (int c = 0; c < board.cols; c++) {
+        std::cout << std::setw(3) << c;
+    }
+    std::cout << std::endl;
+    for (int r = 0; r < board.rows; r++) {
+        std::cout << std::setw(3) << r;
+        for (int c = 0; c < board.cols; c++) {
+            int cell = board.cellOf(r, c);
+            char ch = board.isEmpty(cell) ? '.' : (board.stoneAt(cell) == 0 ? 'X' : 'O');
+            std::cout << "  " << (cell == board.lastMove() ? static_cast<char>(ch + 'a' - 'A') : ch);
+        }
+        std::cout << std::endl;
+    }
+}
+
+// 解析用户输入的坐标
+bool parseUserInput(const MnkBoard& board, std::string input, int& row, int& col) {
+    for (char& ch : input) {
+        if (ch == '(' || ch == ')' || ch == ',') {
+            ch = ' ';
+        }
+    }
+    std::istringstream iss(input);
+    if (iss >> row >> col) {
+        return row >= 0 && row < board.rows && col >= 0 && col < board.cols;
+    }
+    return false;
+}
+
+int runGame(MnkBoard& board, int timeLimit, bool selfPlay, bool useMcts, int threads, const char* bookFile) {
+    MnkEngine engine(1 << 20, threads);
+    OpeningBook book;
+    if (bookFile) {
+        if (book.open(bookFile)) {
+            engine.setBook(&book);
+        } else {
+            std::cout << "Could not open book " << bookFile << std::endl;
+        }
+    }
+    MctsEngine<MnkBoard> mcts(threads);
+
+    std::cout << "m,n,k Game - " << board.rows << "x" << board.cols << ", " << board.k << " in a row" << std::endl;
+    if (!selfPlay) {
+        std::cout << "You are player O, AI is player X" << std::endl;
+        std::cout << "Enter position as \"row col\", e.g., \"7 8\"" << std::endl;
+    }
+
+    while (!board.lastMoveWon() && !board.isFull()) {
+        if (selfPlay || board.currentPlayer() == 0) {
+            if (useMcts) {
+                MctsResult result = mcts.search(board, timeLimit);
+                board.play(result.move);
+                std::cout << (board.currentPlayer() == 1 ? "X" : "O") << " plays " << result.move / board.cols << " "
+                          << result.move % board.cols << "  (win rate " << result.winRate << ", " << result.playouts
+                          << " playouts, " << result.treeNodes << " tree nodes, " << result.seconds << "s)" << std::endl;
+            } else {
+                MnkSearchResult result = engine.search(board, timeLimit);
+                board.play(result.move);
+                std::cout << (board.currentPlayer() == 1 ? "X" : "O") << " plays " << result.move / board.cols << " "
+                          << result.move % board.cols << "  (" << (result.fromBook ? "book, " : "") << (result.threatWin ? "VCF, " : "") << "depth "
+                          << result.depth << ", value " << result.value << ", " << result.nodes << " nodes, "
+                          << result.seconds << "s)" << std::endl;
+            }
+            if (selfPlay) {
+                printBoard(board);
+            }
+        } else {
+            printBoard(board);
+            std::string input;
+            int row, col;
+            while (true) {
+                std::cout << "Your turn (row col): ";
+                if (!std::getline(std::cin, input)) {
+                    return 0;
+                }
+                if (!parseUserInput(board, input, row, col)) {
+                    std::cout << "Invalid input! Please enter row 0-" << board.rows - 1 << " and column 0-" << board.cols - 1 << "." << std::endl;
+                } else if (!board.isEmpty(board.cellOf(row, col))) {
+                    std::cout << "Position " << row << " " << col << " is already taken!" << std::endl;
+                } else {
+                    board.play(board.cellOf(row, col));
+                    break;
+                }
+            }
+        }
+    }
+
+    printBoard(board);
+    if (!board.lastMoveWon()) {
+        std::cout << "It's a draw!" << std::endl;
+    } else if (board.currentPlayer() == 1) {
+        std::cout << (selfPlay ? "X won!" : "AI won!") << std::endl;
+    } else {
+        std::cout << (selfPlay ? "O won!" : "Congratulations, you won!") << std::endl;
+    }
+    return 0;
+}
+
+// 并行搜索基准：先用浅层搜索下出固定的开局，再分别用1、2、4……个线程从同一局面搜索到depth层
+// 加速比 = 单线程用时 / N线程用时，搜索开销 = N线程结点数 / 单线程结点数 - 1
+int runBench(MnkBoard& board, int depth) {
+    MnkEngine opening;
+    for (int i = 0; i < 8 && !board.lastMoveWon() && !board.isFull(); i++) {
+        board.play(opening.search(board, 1000000, 2).move);
+    }
+    printBoard(board);
+
+    int maxThreads = std::max(4, static_cast<int>(std::thread::hardware_concurrency()));
+    double baseSeconds = 0;
+    long long baseNodes = 0;
+    std::cout << "threads   depth  value   move      nodes   seconds  speedup  overhead" << std::endl;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        MnkEngine engine(1 << 20, threads);
+        MnkSearchResult result = engine.search(board, 1000000000, depth);
+        if (threads == 1) {
+            baseSeconds = result.seconds;
+            baseNodes = result.nodes;
+        }
+        std::cout << std::setw(7) << threads << std::setw(8) << result.depth << std::setw(7) << result.value
+                  << std::setw(7) << result.move << std::setw(11) << result.nodes
+                  << std::fixed << std::setprecision(3) << std::setw(10) << result.seconds
+                  << std::setw(8) << std::setprecision(2) << baseSeconds / result.seconds << "x"
+                  << std::setw(9) << std::setprecision(1) << 100.0 * (result.nodes - baseNodes) / baseNodes << "%"
+                  << std::defaultfloat << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    bool selfPlay = false;
+    bool useMcts = false;
+    int threads = 1;
+    const char* bookFile = nullptr;
+    int benchDepth = 0;
+    int args[4] = {15, 15, 5, 1000};
+    int nArgs = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--selfplay") == 0) {
+            selfPlay = true;
+        } else if (std::strcmp(argv[i], "--mcts") == 0) {
+            useMcts = true;
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--book") == 0 && i + 1 < argc) {
+            bookFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            benchDepth = std::atoi(argv[++i]);
+        } else if (nArgs < 4) {
+            args[nArgs++] = std::atoi(argv[i]);
+        }
+    }
+
+    try {
+        MnkBoard board(args[0], args[1], args[2]);
+        if (benchDepth > 0) {
+            return runBench(board, benchDepth);
+        }
+        return runGame(board, args[3], selfPlay, useMcts, threads, bookFile);
+    } catch (const std::invalid_argument& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
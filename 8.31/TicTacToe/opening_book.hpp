@@ -0,0 +1,179 @@
+#ifndef OPENING_BOOK_HPP
+#define OPENING_BOOK_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define OPENING_BOOK_MMAP 1
+#endif
+
+// 开局库文件格式（主机字节序）：
+//   16字节文件头：8字节魔数"OBOOK01"，4字节记录数，4字节记录大小
+//   之后是按(key, depth)升序排列的BookEntry数组
+// 查询时把整个文件映射到内存（没有mmap的平台读入内存），二分查找
+
+struct BookEntry {
+    uint64_t key;    // 局面哈希（井字棋用规范化哈希，m,n,k棋用Zobrist哈希）
+    int32_t value;   // 搜索得到的评估值
+    int16_t move;    // 最佳着法（格子编号）
+    int16_t depth;   // 搜索深度
+};
+
+const char OPENING_BOOK_MAGIC[8] = {'O', 'B', 'O', 'O', 'K', '0', '1', '\0'};
+
+struct BookHeader {
+    char magic[8];
+    uint32_t count;
+    uint32_t entrySize;
+};
+
+inline bool bookEntryLess(const BookEntry& a, const BookEntry& b) {
+    return a.key != b.key ? a.key < b.key : a.depth < b.depth;
+}
+
+// 排序后写出开局库；同一局面同一深度的重复记录只保留一条
+inline bool writeOpeningBook(const std::string& path, std::vector<BookEntry> entries) {
+    std::sort(entries.begin(), entries.end(), bookEntryLess);
+    entries.erase(std::unique(entries.begin(), entries.end(), [](const BookEntry& a, const BookEntry& b) {
+        return a.key == b.key && a.depth == b.depth;
+    }), entries.end());
+
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+    BookHeader header;
+    std::memcpy(header.magic, OPENING_BOOK_MAGIC, sizeof(header.magic));
+    header.count = static_cast<uint32_t>(entries.size());
+    header.entrySize = sizeof(BookEntry);
+    bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1 &&
+              std::fwrite(entries.data(), sizeof(BookEntry), entries.size(), f) == entries.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+// 只读的开局库
+class OpeningBook {
+public:
+    OpeningBook() {}
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    ~OpeningBook() {
+        close();
+    }
+
+    // 打开失败（文件不存在、格式不对）时返回false，此时probe总是查不到
+    bool open(const std::string& path) {
+        close();
+#ifdef OPENING_BOOK_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(BookHeader)) {
+            ::close(fd);
+            return false;
+        }
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            return false;
+        }
+        mapped = p;
+        mappedSize = st.st_size;
+        const char* data = static_cast<const char*>(p);
+#else
+        FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) {
+            return false;
+        }
+        std::fseek(f, 0, SEEK_END);
+        long n = std::ftell(f);
+        std::fseek(f, 0, SEEK_SET);
+        buffer.resize(n > 0 ? n : 0);
+        bool read = n >= static_cast<long>(sizeof(BookHeader)) && std::fread(buffer.data(), 1, n, f) == static_cast<size_t>(n);
+        std::fclose(f);
+        if (!read) {
+            buffer.clear();
+            return false;
+        }
+        const char* data = buffer.data();
+        size_t mappedSize = buffer.size();
+#endif
+        BookHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, OPENING_BOOK_MAGIC, sizeof(header.magic)) != 0 ||
+            header.entrySize != sizeof(BookEntry) ||
+            sizeof(BookHeader) + static_cast<size_t>(header.count) * sizeof(BookEntry) > mappedSize) {
+            close();
+            return false;
+        }
+        entries = reinterpret_cast<const BookEntry*>(data + sizeof(BookHeader));
+        count = header.count;
+        return true;
+    }
+
+    void close() {
+#ifdef OPENING_BOOK_MMAP
+        if (mapped) {
+            munmap(mapped, mappedSize);
+            mapped = nullptr;
+            mappedSize = 0;
+        }
+#else
+        buffer.clear();
+#endif
+        entries = nullptr;
+        count = 0;
+    }
+
+    bool isOpen() const { return entries != nullptr; }
+    size_t size() const { return count; }
+
+    // 查找局面key在搜索深度depth下的记录；depth < 0 时取该局面深度最大的记录
+    bool probe(uint64_t key, int depth, BookEntry& entry) const {
+        if (!entries) {
+            return false;
+        }
+        const BookEntry* end = entries + count;
+        BookEntry target{key, 0, 0, static_cast<int16_t>(depth < 0 ? 0 : depth)};
+        const BookEntry* it = std::lower_bound(entries, end, target, bookEntryLess);
+        if (depth >= 0) {
+            if (it == end || it->key != key || it->depth != depth) {
+                return false;
+            }
+            entry = *it;
+            return true;
+        }
+        if (it == end || it->key != key) {
+            return false;
+        }
+        while (it + 1 != end && (it + 1)->key == key) {
+            ++it;
+        }
+        entry = *it;
+        return true;
+    }
+
+private:
+    const BookEntry* entries = nullptr;
+    size_t count = 0;
+#ifdef OPENING_BOOK_MMAP
+    void* mapped = nullptr;
+    size_t mappedSize = 0;
+#else
+    std::vector<char> buffer;
+#endif
+};
+
+#endif
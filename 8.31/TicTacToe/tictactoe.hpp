@@ -0,0 +1,644 @@
+#ifndef TICTACTOE_HPP
+#define TICTACTOE_HPP
+
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <atomic>
+#include "mcts.hpp"
+#include "opening_book.hpp"
+
+// 井字棋搜索引擎：棋盘状态、Minimax/Alpha-Beta搜索和置换表，v2命令行版和v3图形版共用
+
+// 8条连线（3行、3列、2条对角线）的掩码，格子 (行, 列) 对应第 行*3+列 位
+constexpr uint16_t WIN_LINES[8] = {
+    0x007, 0x038, 0x1C0, // 行
+    0x049, 0x092, 0x124, // 列
+    0x111, 0x054         // 对角线
+};
+
+constexpr uint16_t FULL_BOARD = 0x1FF;
+
+// WIN_TABLE[mask]表示占据mask这些格子的一方是否已经连成一线，编译期由WIN_LINES生成
+struct WinTable {
+    bool win[512];
+
+    constexpr WinTable() : win() {
+        for (int mask = 0; mask < 512; mask++) {
+            for (int i = 0; i < 8; i++) {
+                if ((mask & WIN_LINES[i]) == WIN_LINES[i]) {
+                    win[mask] = true;
+                }
+            }
+        }
+    }
+};
+
+constexpr WinTable WIN_TABLE;
+
+// 井字棋游戏状态
+class TicTacToeState {
+public:
+    uint16_t xMask; // X占据的格子
+    uint16_t oMask; // O占据的格子
+    char currentPlayer; // 当前玩家 ('X' 或 'O')
+
+    // 构造函数，初始化空棋盘
+    TicTacToeState() : xMask(0), oMask(0), currentPlayer('X') {} // X先手
+
+    // 格子上的棋子：'X'、'O' 或 ' '
+    char at(int row, int col) const {
+        uint16_t bit = static_cast<uint16_t>(1u << (row * 3 + col));
+        return (xMask & bit) ? 'X' : ((oMask & bit) ? 'O' : ' ');
+    }
+
+    // 空格子的掩码
+    uint16_t emptyMask() const {
+        return static_cast<uint16_t>(FULL_BOARD & ~(xMask | oMask));
+    }
+
+    // 判断是否是终止状态：有玩家获胜或棋盘已满
+    bool isTerminal() const {
+        return checkWin('X') || checkWin('O') || emptyMask() == 0;
+    }
+
+    // 检查玩家是否获胜
+    bool checkWin(char player) const {
+        return WIN_TABLE.win[(player == 'X') ? xMask : oMask];
+    }
+
+    // 获取状态的评估值
+    int evaluate() const {
+        if (checkWin('X')) {
+            return 10; // X获胜，返回正分
+        } else if (checkWin('O')) {
+            return -10; // O获胜，返回负分
+        } else {
+            return 0; // 平局或者游戏未结束
+        }
+    }
+
+    // 当前玩家在格子cell（行*3+列）落子并切换玩家，调用前须保证格子为空
+    void play(int cell) {
+        if (currentPlayer == 'X') {
+            xMask |= static_cast<uint16_t>(1u << cell);
+            currentPlayer = 'O';
+        } else {
+            oMask |= static_cast<uint16_t>(1u << cell);
+            currentPlayer = 'X';
+        }
+    }
+
+    // 撤销格子cell上的落子，与play配对使用
+    void undo(int cell) {
+        uint16_t clear = static_cast<uint16_t>(~(1u << cell));
+        xMask &= clear;
+        oMask &= clear;
+        currentPlayer = (currentPlayer == 'X') ? 'O' : 'X';
+    }
+
+    // 执行移动并返回移动是否有效
+    bool makeMove(int row, int col) {
+        if (row >= 0 && row < 3 && col >= 0 && col < 3 && at(row, col) == ' ') {
+            play(row * 3 + col);
+            return true;
+        }
+        return false;
+    }
+
+    // 打印棋盘
+    void printBoard() const {
+        std::cout << "-------------" << std::endl;
+        for (int i = 0; i < 3; i++) {
+            std::cout << "| ";
+            for (int j = 0; j < 3; j++) {
+                std::cout << at(i, j) << " | ";
+            }
+            std::cout << std::endl << "-------------" << std::endl;
+        }
+    }
+};
+
+// 掩码中最低位的1所在的格子
+inline int lowestCell(unsigned mask) {
+    return __builtin_ctz(mask);
+}
+
+// 搜索统计：stats参数不为空时累计访问的结点数、剪枝次数和置换表命中次数（基准测试用）
+struct SearchStats {
+    long long nodes = 0;
+    long long cutoffs = 0;
+    long long ttHits = 0;
+};
+
+// 以下搜索函数都在state上原地落子/悔棋来生成后继，返回时state恢复原状
+
+// Minimax核心算法
+inline int minimax(TicTacToeState& state, int depth, bool maximizingPlayer, SearchStats* stats = nullptr) {
+    if (stats) {
+        stats->nodes++;
+    }
+
+    // 如果到达终止状态或深度限制，返回评估值（评估值非0即有人获胜）
+    int score = state.evaluate();
+    if (depth == 0 || score != 0 || state.emptyMask() == 0) {
+        return score;
+    }
+
+    int bestValue = maximizingPlayer ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+    for (unsigned moves = state.emptyMask(); moves; moves &= moves - 1) {
+        int cell = lowestCell(moves);
+        state.play(cell);
+        int v = minimax(state, depth - 1, !maximizingPlayer, stats);
+        state.undo(cell);
+
+        if (maximizingPlayer) {
+            bestValue = std::max(bestValue, v); // 最大化玩家
+        } else {
+            bestValue = std::min(bestValue, v); // 最小化玩家
+        }
+    }
+    return bestValue;
+}
+
+// 带Alpha-Beta剪枝的Minimax算法
+inline int minimaxAlphaBeta(TicTacToeState& state, int depth, int alpha, int beta, bool maximizingPlayer,
+                            SearchStats* stats = nullptr) {
+    if (stats) {
+        stats->nodes++;
+    }
+
+    // 如果到达终止状态或深度限制，返回评估值（评估值非0即有人获胜）
+    int score = state.evaluate();
+    if (depth == 0 || score != 0 || state.emptyMask() == 0) {
+        return score;
+    }
+
+    int bestValue = maximizingPlayer ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+    for (unsigned moves = state.emptyMask(); moves; moves &= moves - 1) {
+        int cell = lowestCell(moves);
+        state.play(cell);
+        int v = minimaxAlphaBeta(state, depth - 1, alpha, beta, !maximizingPlayer, stats);
+        state.undo(cell);
+
+        if (maximizingPlayer) {
+            // 最大化玩家
+            bestValue = std::max(bestValue, v);
+            alpha = std::max(alpha, bestValue);
+        } else {
+            // 最小化玩家
+            bestValue = std::min(bestValue, v);
+            beta = std::min(beta, bestValue);
+        }
+        if (beta <= alpha) {
+            if (stats) {
+                stats->cutoffs++;
+            }
+            break; // 剪枝
+        }
+    }
+    return bestValue;
+}
+
+// Zobrist随机数：每个格子上的X、O各一个64位随机数，另有一个表示轮到O走
+struct ZobristKeys {
+    uint64_t cell[9][2];
+    uint64_t sideO;
+
+    ZobristKeys() {
+        // 固定种子的splitmix64，保证每次运行的哈希值相同
+        uint64_t seed = 0x9E3779B97F4A7C15ULL;
+        auto next = [&seed]() {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        };
+        for (int i = 0; i < 9; i++) {
+            cell[i][0] = next();
+            cell[i][1] = next();
+        }
+        sideO = next();
+    }
+};
+
+inline const ZobristKeys& zobristKeys() {
+    static const ZobristKeys keys;
+    return keys;
+}
+
+// 棋盘的8种旋转/翻转：SYMMETRY[t][i]为格子i在变换t下的位置（格子编号为 行*3+列）
+const int SYMMETRY[8][9] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8}, // 不变
+    {2, 5, 8, 1, 4, 7, 0, 3, 6}, // 旋转90度
+    {8, 7, 6, 5, 4, 3, 2, 1, 0}, // 旋转180度
+    {6, 3, 0, 7, 4, 1, 8, 5, 2}, // 旋转270度
+    {2, 1, 0, 5, 4, 3, 8, 7, 6}, // 左右翻转
+    {6, 7, 8, 3, 4, 5, 0, 1, 2}, // 上下翻转
+    {0, 3, 6, 1, 4, 7, 2, 5, 8}, // 主对角线翻转
+    {8, 5, 2, 7, 4, 1, 6, 3, 0}  // 副对角线翻转
+};
+
+// 局面经过变换t之后的Zobrist哈希（不含轮到谁走）
+inline uint64_t symmetryHash(const TicTacToeState& state, int t) {
+    const ZobristKeys& keys = zobristKeys();
+    uint64_t h = 0;
+    for (unsigned m = state.xMask; m; m &= m - 1) {
+        h ^= keys.cell[SYMMETRY[t][lowestCell(m)]][0];
+    }
+    for (unsigned m = state.oMask; m; m &= m - 1) {
+        h ^= keys.cell[SYMMETRY[t][lowestCell(m)]][1];
+    }
+    return h;
+}
+
+// 哈希最小的变换，即把局面变到规范朝向的变换；hash不为空时同时给出该哈希
+inline int canonicalSymmetry(const TicTacToeState& state, uint64_t* hash = nullptr) {
+    int best = 0;
+    uint64_t bestHash = symmetryHash(state, 0);
+    for (int t = 1; t < 8; t++) {
+        uint64_t h = symmetryHash(state, t);
+        if (h < bestHash) {
+            bestHash = h;
+            best = t;
+        }
+    }
+    if (hash) {
+        *hash = bestHash;
+    }
+    return best;
+}
+
+// 规范化哈希：取8种对称局面的Zobrist哈希中最小的一个，对称的局面因此共用同一个置换表项
+inline uint64_t canonicalHash(const TicTacToeState& state) {
+    uint64_t best;
+    canonicalSymmetry(state, &best);
+    if (state.currentPlayer == 'O') {
+        best ^= zobristKeys().sideO;
+    }
+    return best;
+}
+
+// 对局面做变换t
+inline TicTacToeState transformState(const TicTacToeState& state, int t) {
+    TicTacToeState result = state;
+    result.xMask = 0;
+    result.oMask = 0;
+    for (unsigned m = state.xMask; m; m &= m - 1) {
+        result.xMask |= static_cast<uint16_t>(1u << SYMMETRY[t][lowestCell(m)]);
+    }
+    for (unsigned m = state.oMask; m; m &= m - 1) {
+        result.oMask |= static_cast<uint16_t>(1u << SYMMETRY[t][lowestCell(m)]);
+    }
+    return result;
+}
+
+// 置换表中保存的值的类型：精确值、下界（发生了beta剪枝）、上界（没有超过alpha）
+enum class BoundType : unsigned char {
+    EXACT,
+    LOWER,
+    UPPER
+};
+
+struct TTEntry {
+    uint64_t key;
+    int value;
+    short depth;     // 得到该值时的剩余搜索深度
+    BoundType bound;
+    bool used;
+};
+
+// 置换表：按哈希低位直接寻址，同一位置优先保留搜索深度更大的结果
+class TranspositionTable {
+public:
+    // size会向上取整为2的幂
+    explicit TranspositionTable(size_t size = 1 << 16) {
+        size_t capacity = 1;
+        while (capacity < size) {
+            capacity <<= 1;
+        }
+        entries.assign(capacity, TTEntry{0, 0, 0, BoundType::EXACT, false});
+        mask = capacity - 1;
+    }
+
+    bool probe(uint64_t key, TTEntry& entry) const {
+        const TTEntry& e = entries[key & mask];
+        if (e.used && e.key == key) {
+            entry = e;
+            return true;
+        }
+        return false;
+    }
+
+    void store(uint64_t key, int value, int depth, BoundType bound) {
+        TTEntry& e = entries[key & mask];
+        if (e.used && e.key != key && e.depth > depth) {
+            return;
+        }
+        e = TTEntry{key, value, static_cast<short>(depth), bound, true};
+    }
+
+    void clear() {
+        std::fill(entries.begin(), entries.end(), TTEntry{0, 0, 0, BoundType::EXACT, false});
+    }
+
+private:
+    std::vector<TTEntry> entries;
+    size_t mask;
+};
+
+// findBestMove在多步之间共用的置换表（表项带有剩余深度，不同难度之间也可以共用）
+inline TranspositionTable& globalTranspositionTable() {
+    static TranspositionTable table;
+    return table;
+}
+
+// 在另一个线程上搜索时的控制块：cancelled置位后搜索尽快返回；depthReached、nodes供界面显示进度
+struct SearchControl {
+    std::atomic<bool> cancelled{false};
+    std::atomic<int> depthReached{0};
+    std::atomic<long long> nodes{0};
+};
+
+// 带置换表的Alpha-Beta剪枝，返回值与minimaxAlphaBeta相同
+// control不为空时统计结点数并检查取消；被取消时返回值无意义，也不会写入置换表
+inline int minimaxAlphaBetaTT(TicTacToeState& state, int depth, int alpha, int beta, bool maximizingPlayer,
+                              TranspositionTable& table, SearchControl* control = nullptr,
+                              SearchStats* stats = nullptr) {
+    if (stats) {
+        stats->nodes++;
+    }
+    if (control) {
+        control->nodes.fetch_add(1, std::memory_order_relaxed);
+        if (control->cancelled.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+    }
+
+    int score = state.evaluate();
+    if (depth == 0 || score != 0 || state.emptyMask() == 0) {
+        return score;
+    }
+
+    // 剩余深度不少于空格数时就是完整搜索，统一记为空格数，这样不同难度的完整搜索结果可以共用
+    depth = std::min(depth, __builtin_popcount(state.emptyMask()));
+
+    // 查表：只用深度相同的结果（深度受限时更深的结果会改变难度对应的棋力），
+    // 精确值直接返回，上下界用来收缩窗口
+    uint64_t key = canonicalHash(state);
+    TTEntry entry;
+    if (table.probe(key, entry) && entry.depth == depth) {
+        if (stats) {
+            stats->ttHits++;
+        }
+        if (entry.bound == BoundType::EXACT) {
+            return entry.value;
+        } else if (entry.bound == BoundType::LOWER) {
+            alpha = std::max(alpha, entry.value);
+        } else {
+            beta = std::min(beta, entry.value);
+        }
+        if (beta <= alpha) {
+            return entry.value;
+        }
+    }
+
+    int originalAlpha = alpha;
+    int originalBeta = beta;
+    int bestValue = maximizingPlayer ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+
+    for (unsigned moves = state.emptyMask(); moves; moves &= moves - 1) {
+        int cell = lowestCell(moves);
+        state.play(cell);
+        int v = minimaxAlphaBetaTT(state, depth - 1, alpha, beta, !maximizingPlayer, table, control, stats);
+        state.undo(cell);
+
+        if (maximizingPlayer) {
+            bestValue = std::max(bestValue, v);
+            alpha = std::max(alpha, bestValue);
+        } else {
+            bestValue = std::min(bestValue, v);
+            beta = std::min(beta, bestValue);
+        }
+        if (beta <= alpha) {
+            if (stats) {
+                stats->cutoffs++;
+            }
+            break; // 剪枝
+        }
+    }
+
+    if (control && control->cancelled.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+
+    // 存表：值以X的视角记录，上下界的判断对MAX、MIN结点相同
+    BoundType bound = BoundType::EXACT;
+    if (bestValue <= originalAlpha) {
+        bound = BoundType::UPPER;
+    } else if (bestValue >= originalBeta) {
+        bound = BoundType::LOWER;
+    }
+    table.store(key, bestValue, depth, bound);
+    return bestValue;
+}
+
+// 完美对弈表：编译期对所有局面做完整的Minimax，按三进制局面编码保存评估值和最佳着法
+// 局面编码 = Σ 格子i的棋子 × 3^i（空为0，X为1，O为2），共3^9 = 19683项
+constexpr int POSITION_CODES = 19683;
+
+struct PerfectPlayEntry {
+    signed char value; // X视角的完整搜索值：10、-10或0
+    signed char move;  // 轮到的一方的最佳着法（格子编号），终局或非法局面为-1
+};
+
+struct PerfectPlayTable {
+    PerfectPlayEntry entries[POSITION_CODES];
+
+    // 在空格上落子时编码一定增大，所以从大到小计算即可保证后继局面已经算好
+    constexpr PerfectPlayTable() : entries() {
+        int pow3[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+        for (int code = POSITION_CODES - 1; code >= 0; code--) {
+            int xMask = 0, oMask = 0, xCount = 0, oCount = 0;
+            for (int i = 0, rest = code; i < 9; i++, rest /= 3) {
+                if (rest % 3 == 1) {
+                    xMask |= 1 << i;
+                    xCount++;
+                } else if (rest % 3 == 2) {
+                    oMask |= 1 << i;
+                    oCount++;
+                }
+            }
+
+            entries[code] = PerfectPlayEntry{0, -1};
+            if (xCount != oCount && xCount != oCount + 1) {
+                continue; // 子数不合法
+            }
+            if (WIN_TABLE.win[xMask] || WIN_TABLE.win[oMask] || xCount + oCount == 9) {
+                entries[code].value = static_cast<signed char>(WIN_TABLE.win[xMask] ? 10 : (WIN_TABLE.win[oMask] ? -10 : 0));
+                continue;
+            }
+
+            // X走时取最大值，O走时取最小值；同值时取编号最小的格子，与findBestMove的顺序一致
+            bool xToMove = (xCount == oCount);
+            int best = xToMove ? -100 : 100;
+            for (int i = 0; i < 9; i++) {
+                if (((xMask | oMask) >> i) & 1) {
+                    continue;
+                }
+                int v = entries[code + (xToMove ? 1 : 2) * pow3[i]].value;
+                if (xToMove ? v > best : v < best) {
+                    best = v;
+                    entries[code].move = static_cast<signed char>(i);
+                }
+            }
+            entries[code].value = static_cast<signed char>(best);
+        }
+    }
+};
+
+inline constexpr PerfectPlayTable PERFECT_PLAY_TABLE;
+
+// 局面的三进制编码
+inline int positionCode(const TicTacToeState& state) {
+    static const int pow3[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+    int code = 0;
+    for (unsigned m = state.xMask; m; m &= m - 1) {
+        code += pow3[lowestCell(m)];
+    }
+    for (unsigned m = state.oMask; m; m &= m - 1) {
+        code += 2 * pow3[lowestCell(m)];
+    }
+    return code;
+}
+
+// 对深度depth做一次根结点搜索，返回最佳移动的位置（行、列）
+inline std::pair<int, int> searchBestMove(TicTacToeState& state, int depth, TranspositionTable& table,
+                                          SearchControl* control = nullptr) {
+    int bestRow = -1;
+    int bestCol = -1;
+    int bestValue = std::numeric_limits<int>::min();
+
+    // 遍历所有可能的移动
+    for (unsigned moves = state.emptyMask(); moves; moves &= moves - 1) {
+        int cell = lowestCell(moves);
+
+        // 尝试这个移动，评估后撤销（转置和对称的局面都从置换表中取结果）
+        state.play(cell);
+        int moveValue = minimaxAlphaBetaTT(state, depth - 1, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), false, table, control);
+        state.undo(cell);
+
+        // 如果这个移动比之前找到的最佳移动更好，则更新最佳移动
+        if (moveValue > bestValue) {
+            bestValue = moveValue;
+            bestRow = cell / 3;
+            bestCol = cell % 3;
+        }
+    }
+    
+    return std::make_pair(bestRow, bestCol);
+}
+
+// 开局库：由book_builder离线生成，键为规范化哈希，着法按规范朝向保存；文件不存在时不使用
+const char* const TICTACTOE_BOOK_FILE = "tictactoe.book";
+
+inline const OpeningBook& tictactoeBook() {
+    static OpeningBook book;
+    static bool opened = book.open(TICTACTOE_BOOK_FILE);
+    (void)opened;
+    return book;
+}
+
+// 在开局库中查找局面在搜索深度depth下的最佳着法，并从规范朝向变换回当前朝向
+inline bool probeBook(const OpeningBook& book, const TicTacToeState& state, int depth, int& cell) {
+    BookEntry entry;
+    if (!book.probe(canonicalHash(state), depth, entry)) {
+        return false;
+    }
+    int t = canonicalSymmetry(state);
+    for (int i = 0; i < 9; i++) {
+        if (SYMMETRY[t][i] == entry.move) {
+            cell = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 找到最佳移动的位置（行、列）
+// 给出control时按深度1..depth迭代加深，每完成一层更新control->depthReached；
+// 被取消时返回已完成的最深一层的结果（一层都没完成时为(-1, -1)）
+inline std::pair<int, int> findBestMove(TicTacToeState& state, int depth, SearchControl* control = nullptr) {
+    TranspositionTable& table = globalTranspositionTable();
+
+    // 搜索深度覆盖所有空格时结果就是完整Minimax，直接查完美对弈表
+    if (depth >= __builtin_popcount(state.emptyMask()) && !state.isTerminal()) {
+        int cell = PERFECT_PLAY_TABLE.entries[positionCode(state)].move;
+        if (control) {
+            control->depthReached = depth;
+        }
+        return std::make_pair(cell / 3, cell % 3);
+    }
+
+    // 其次查开局库（只收录深度不覆盖全部空格的搜索结果）
+    int bookCell;
+    if (probeBook(tictactoeBook(), state, depth, bookCell) && state.at(bookCell / 3, bookCell % 3) == ' ') {
+        if (control) {
+            control->depthReached = depth;
+        }
+        return std::make_pair(bookCell / 3, bookCell % 3);
+    }
+
+    if (!control) {
+        return searchBestMove(state, depth, table);
+    }
+
+    std::pair<int, int> best(-1, -1);
+    for (int d = 1; d <= depth; d++) {
+        std::pair<int, int> move = searchBestMove(state, d, table, control);
+        if (control->cancelled) {
+            break;
+        }
+        best = move;
+        control->depthReached = d;
+    }
+    return best;
+}
+
+// 井字棋接入MCTS：X为玩家0，O为玩家1
+template <>
+struct MctsGame<TicTacToeState> {
+    static void legalMoves(const TicTacToeState& s, std::vector<int>& moves) {
+        moves.clear();
+        for (unsigned m = s.emptyMask(); m; m &= m - 1) {
+            moves.push_back(lowestCell(m));
+        }
+    }
+
+    // 在空格掩码中随机取一位
+    static int randomMove(const TicTacToeState& s, uint64_t& rng) {
+        unsigned m = s.emptyMask();
+        for (int r = static_cast<int>(mctsRandom(rng) % __builtin_popcount(m)); r > 0; r--) {
+            m &= m - 1;
+        }
+        return lowestCell(m);
+    }
+
+    static void play(TicTacToeState& s, int move) { s.play(move); }
+    static void undo(TicTacToeState& s, int move) { s.undo(move); }
+    static int toMove(const TicTacToeState& s) { return s.currentPlayer == 'X' ? 0 : 1; }
+
+    static int winner(const TicTacToeState& s) {
+        if (s.checkWin('X')) return 0;
+        if (s.checkWin('O')) return 1;
+        return s.emptyMask() == 0 ? 2 : -1;
+    }
+
+    static uint64_t key(const TicTacToeState& s) {
+        return s.xMask | (static_cast<uint64_t>(s.oMask) << 9);
+    }
+};
+
+#endif
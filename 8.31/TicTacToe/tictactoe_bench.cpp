@@ -0,0 +1,387 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include "tictactoe.hpp"
+#include "mnk_engine.hpp"
+
+// 搜索基准：对所有开局局面（空棋盘及其后一、两步，共82个）在深度1-9上分别运行各搜索引擎，
+// 以CSV输出结点数、剪枝次数、置换表命中次数、每步用时、每秒结点数和有效分支因子。
+// 之后是m,n,k引擎（mnk_pvs，固定深度，3x3用同样的开局局面，另有几个15x15五子棋局面）和
+// MCTS（mcts，固定模拟次数）的行：这两种引擎不统计剪枝和置换表命中，对应列留空；
+// mnk_pvs的value为当前玩家视角的评分，mcts的depth为模拟次数、value为所选着法的胜率（千分比）、nodes为模拟次数
+// 用法：tictactoe_bench            输出CSV到标准输出，按引擎和深度汇总的结果输出到标准错误
+//       tictactoe_bench --selfplay 自我对弈一致性检查：沿着对局的每个局面比较各引擎在各深度的值
+
+typedef int (*EngineFn)(TicTacToeState& state, int depth, SearchStats& stats);
+
+int runMinimax(TicTacToeState& state, int depth, SearchStats& stats) {
+    return minimax(state, depth, state.currentPlayer == 'X', &stats);
+}
+
+int runAlphaBeta(TicTacToeState& state, int depth, SearchStats& stats) {
+    return minimaxAlphaBeta(state, depth, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(),
+                            state.currentPlayer == 'X', &stats);
+}
+
+// 基准用的小置换表，每次搜索前清空（不计入用时），避免前一次搜索的结果影响结点数
+TranspositionTable& benchTable() {
+    static TranspositionTable table(1 << 13);
+    return table;
+}
+
+void clearBenchTable() {
+    benchTable().clear();
+}
+
+int runAlphaBetaTT(TicTacToeState& state, int depth, SearchStats& stats) {
+    return minimaxAlphaBetaTT(state, depth, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(),
+                              state.currentPlayer == 'X', benchTable(), nullptr, &stats);
+}
+
+// 完美对弈表只给出完整搜索的值，深度不覆盖所有空格时返回普通Alpha-Beta的值
+int runPerfectTable(TicTacToeState& state, int depth, SearchStats& stats) {
+    if (depth >= __builtin_popcount(state.emptyMask())) {
+        stats.nodes++;
+        return PERFECT_PLAY_TABLE.entries[positionCode(state)].value;
+    }
+    return runAlphaBeta(state, depth, stats);
+}
+
+struct Engine {
+    const char* name;
+    EngineFn run;
+    void (*reset)(); // 每次搜索前调用，可以为空
+};
+
+const Engine ENGINES[] = {
+    {"minimax", runMinimax, nullptr},
+    {"alphabeta", runAlphaBeta, nullptr},
+    {"alphabeta_tt", runAlphaBetaTT, clearBenchTable},
+    {"perfect_table", runPerfectTable, nullptr},
+};
+const int ENGINE_COUNT = sizeof(ENGINES) / sizeof(ENGINES[0]);
+
+// 局面写成9个字符，空格用'.'
+std::string boardString(const TicTacToeState& state) {
+    std::string s;
+    for (int i = 0; i < 9; i++) {
+        char c = state.at(i / 3, i % 3);
+        s += (c == ' ') ? '.' : c;
+    }
+    return s;
+}
+
+// 空棋盘、X的9种第一步、以及每种第一步之后O的8种应对
+std::vector<TicTacToeState> openingPositions() {
+    std::vector<TicTacToeState> positions;
+    TicTacToeState empty;
+    positions.push_back(empty);
+    for (int a = 0; a < 9; a++) {
+        TicTacToeState s1 = empty;
+        s1.play(a);
+        positions.push_back(s1);
+    }
+    for (int a = 0; a < 9; a++) {
+        for (int b = 0; b < 9; b++) {
+            if (a != b) {
+                TicTacToeState s2 = empty;
+                s2.play(a);
+                s2.play(b);
+                positions.push_back(s2);
+            }
+        }
+    }
+    return positions;
+}
+
+// 有效分支因子：满足 b + b^2 + ... + b^d = nodes - 1 的b，用二分法求解
+double effectiveBranchingFactor(long long nodes, int depth) {
+    if (nodes <= 1 || depth <= 0) {
+        return 0.0;
+    }
+    double lo = 0.0, hi = std::max(10.0, static_cast<double>(nodes)); // 分支因子不会超过结点数
+    for (int iter = 0; iter < 60; iter++) {
+        double b = (lo + hi) / 2, sum = 0, term = 1;
+        for (int i = 1; i <= depth; i++) {
+            term *= b;
+            sum += term;
+        }
+        if (sum < nodes - 1) {
+            lo = b;
+        } else {
+            hi = b;
+        }
+    }
+    return (lo + hi) / 2;
+}
+
+// 对一个局面运行一次搜索并计时；很快的搜索重复到至少1毫秒再取平均
+double timeSearch(const Engine& engine, const TicTacToeState& position, int depth, SearchStats& stats, int& value) {
+    TicTacToeState state = position;
+    if (engine.reset) {
+        engine.reset();
+    }
+    value = engine.run(state, depth, stats);
+
+    double total = 0.0;
+    int reps = 0;
+    while (total < 1e-3) {
+        SearchStats ignored;
+        if (engine.reset) {
+            engine.reset();
+        }
+        auto start = std::chrono::steady_clock::now();
+        engine.run(state, depth, ignored);
+        total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        reps++;
+    }
+    return total / reps;
+}
+
+// 按落子顺序还原井字棋局面的着法：X先手，双方交替
+std::vector<int> replayMoves(const TicTacToeState& state) {
+    std::vector<int> xCells, oCells, moves;
+    for (int i = 0; i < 9; i++) {
+        if (state.at(i / 3, i % 3) == 'X') {
+            xCells.push_back(i);
+        } else if (state.at(i / 3, i % 3) == 'O') {
+            oCells.push_back(i);
+        }
+    }
+    for (size_t i = 0; i < xCells.size(); i++) {
+        moves.push_back(xCells[i]);
+        if (i < oCells.size()) {
+            moves.push_back(oCells[i]);
+        }
+    }
+    return moves;
+}
+
+// m,n,k引擎和MCTS的基准局面
+struct MnkPosition {
+    std::string name;
+    int rows, cols, k;
+    std::vector<int> moves; // 依次落子的格子
+    int maxDepth;           // mnk_pvs搜索的最大深度
+    long long playouts;     // MCTS的模拟次数
+};
+
+std::vector<MnkPosition> mnkPositions() {
+    std::vector<MnkPosition> positions;
+    for (const TicTacToeState& state : openingPositions()) {
+        positions.push_back(MnkPosition{boardString(state), 3, 3, 3, replayMoves(state), 9, 20000});
+    }
+    // 15x15五子棋：中心一子、开局三子、中盘八子（格子编号为 行*15+列，中心为112）
+    positions.push_back(MnkPosition{"15x15k5:center", 15, 15, 5, {112}, 4, 2000});
+    positions.push_back(MnkPosition{"15x15k5:open3", 15, 15, 5, {112, 113, 97}, 4, 2000});
+    positions.push_back(MnkPosition{"15x15k5:mid8", 15, 15, 5, {112, 128, 113, 111, 98, 126, 127, 143}, 4, 2000});
+    return positions;
+}
+
+MnkBoard makeBoard(const MnkPosition& position) {
+    MnkBoard board(position.rows, position.cols, position.k);
+    for (int cell : position.moves) {
+        board.play(cell);
+    }
+    return board;
+}
+
+// 一次固定深度的PVS搜索并计时，每次搜索前清空置换表（不计入用时）；很快的搜索重复到至少1毫秒再取平均
+double timeMnkSearch(MnkEngine& engine, const MnkPosition& position, int depth, MnkSearchResult& result) {
+    const int NO_TIME_LIMIT = 3600 * 1000;
+    MnkBoard board = makeBoard(position);
+    engine.clear();
+    result = engine.search(board, NO_TIME_LIMIT, depth);
+
+    double total = 0.0;
+    int reps = 0;
+    while (total < 1e-3) {
+        engine.clear();
+        auto start = std::chrono::steady_clock::now();
+        engine.search(board, NO_TIME_LIMIT, depth);
+        total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        reps++;
+    }
+    return total / reps;
+}
+
+// 一次固定模拟次数的单线程MCTS搜索，每次从空树开始
+template <class State>
+MctsResult runMcts(const State& state, long long playouts) {
+    MctsEngine<State> engine(1);
+    engine.reset();
+    return engine.search(state, 0, playouts);
+}
+
+// mnk_pvs和mcts的CSV行，汇总输出到标准错误
+void runMnkBench() {
+    std::vector<MnkPosition> positions = mnkPositions();
+    MnkEngine engine(1 << 16);
+
+    // 汇总按棋盘（3x3为所有开局局面的平均，15x15逐个局面）和深度分组
+    std::map<std::pair<std::string, int>, std::pair<long long, double>> pvsTotals; // (分组, 深度) -> (结点数, 秒)
+    std::map<std::string, int> groupSize;
+    std::map<std::string, std::pair<long long, double>> mctsTotals; // 分组 -> (模拟次数, 秒)
+
+    for (const MnkPosition& position : positions) {
+        std::string group = position.rows == 3 ? "3x3" : position.name;
+        groupSize[group]++;
+        int empties = position.rows * position.cols - static_cast<int>(position.moves.size());
+        for (int depth = 1; depth <= position.maxDepth; depth++) {
+            MnkSearchResult result;
+            double t = timeMnkSearch(engine, position, depth, result);
+            std::cout << "mnk_pvs," << position.name << "," << depth << "," << result.value << ","
+                      << result.nodes << ",,,"
+                      << std::fixed << std::setprecision(3) << t * 1e6 << ","
+                      << std::setprecision(0) << result.nodes / t << ","
+                      << std::setprecision(3) << effectiveBranchingFactor(result.nodes, std::min(depth, empties))
+                      << std::defaultfloat << std::endl;
+            pvsTotals[{group, depth}].first += result.nodes;
+            pvsTotals[{group, depth}].second += t;
+        }
+
+        MctsResult result;
+        if (position.rows == 3) {
+            TicTacToeState state;
+            for (int cell : position.moves) {
+                state.play(cell);
+            }
+            result = runMcts(state, position.playouts);
+        } else {
+            result = runMcts(makeBoard(position), position.playouts);
+        }
+        std::cout << "mcts," << position.name << "," << position.playouts << ","
+                  << static_cast<int>(std::lround(result.winRate * 1000)) << "," << result.playouts << ",,,"
+                  << std::fixed << std::setprecision(3) << result.seconds * 1e6 << ","
+                  << std::setprecision(0) << result.playouts / result.seconds << ","
+                  << std::defaultfloat << std::endl;
+        mctsTotals[group].first += result.playouts;
+        mctsTotals[group].second += result.seconds;
+    }
+
+    std::cerr << std::endl << std::left << std::setw(18) << "mnk_pvs" << std::right << std::setw(6) << "depth"
+              << std::setw(12) << "nodes/move" << std::setw(12) << "us/move" << std::setw(14) << "nodes/sec" << std::endl;
+    for (const auto& [key, totals] : pvsTotals) {
+        double n = groupSize[key.first];
+        std::cerr << std::left << std::setw(18) << key.first << std::right << std::setw(6) << key.second
+                  << std::fixed << std::setprecision(1) << std::setw(12) << totals.first / n
+                  << std::setprecision(2) << std::setw(12) << totals.second * 1e6 / n
+                  << std::setprecision(0) << std::setw(14) << totals.first / totals.second
+                  << std::defaultfloat << std::endl;
+    }
+    std::cerr << std::endl << std::left << std::setw(18) << "mcts" << std::right << std::setw(14) << "playouts/sec"
+              << std::endl;
+    for (const auto& [group, totals] : mctsTotals) {
+        std::cerr << std::left << std::setw(18) << group << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(14) << totals.first / totals.second << std::defaultfloat << std::endl;
+    }
+}
+
+int runBench() {
+    std::vector<TicTacToeState> positions = openingPositions();
+    SearchStats totals[ENGINE_COUNT][10];
+    double seconds[ENGINE_COUNT][10] = {};
+
+    std::cout << "engine,position,depth,value,nodes,cutoffs,tt_hits,time_us,nodes_per_sec,ebf" << std::endl;
+    for (int e = 0; e < ENGINE_COUNT; e++) {
+        for (const TicTacToeState& position : positions) {
+            for (int depth = 1; depth <= 9; depth++) {
+                SearchStats stats;
+                int value;
+                double t = timeSearch(ENGINES[e], position, depth, stats, value);
+                int searched = std::min(depth, __builtin_popcount(position.emptyMask()));
+
+                std::cout << ENGINES[e].name << "," << boardString(position) << "," << depth << "," << value << ","
+                          << stats.nodes << "," << stats.cutoffs << "," << stats.ttHits << ","
+                          << std::fixed << std::setprecision(3) << t * 1e6 << ","
+                          << std::setprecision(0) << stats.nodes / t << ","
+                          << std::setprecision(3) << effectiveBranchingFactor(stats.nodes, searched)
+                          << std::defaultfloat << std::endl;
+
+                totals[e][depth].nodes += stats.nodes;
+                totals[e][depth].cutoffs += stats.cutoffs;
+                totals[e][depth].ttHits += stats.ttHits;
+                seconds[e][depth] += t;
+            }
+        }
+    }
+
+    // 汇总：每个引擎每个深度在所有开局局面上的平均值
+    std::cerr << std::left << std::setw(15) << "engine" << std::right << std::setw(6) << "depth"
+              << std::setw(12) << "nodes/move" << std::setw(12) << "cutoffs" << std::setw(12) << "tt_hits"
+              << std::setw(12) << "us/move" << std::setw(14) << "nodes/sec" << std::endl;
+    for (int e = 0; e < ENGINE_COUNT; e++) {
+        for (int depth = 1; depth <= 9; depth++) {
+            double n = static_cast<double>(positions.size());
+            std::cerr << std::left << std::setw(15) << ENGINES[e].name << std::right << std::setw(6) << depth
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(12) << totals[e][depth].nodes / n << std::setw(12) << totals[e][depth].cutoffs / n
+                      << std::setw(12) << totals[e][depth].ttHits / n
+                      << std::setprecision(2) << std::setw(12) << seconds[e][depth] * 1e6 / n
+                      << std::setprecision(0) << std::setw(14) << totals[e][depth].nodes / seconds[e][depth]
+                      << std::defaultfloat << std::endl;
+        }
+    }
+
+    runMnkBench();
+    return 0;
+}
+
+// 从每个开局局面开始用完整搜索（findBestMove深度9）自我对弈，对局中的每个局面都要求各引擎在各深度上的值相同，
+// 并且findBestMove选出的着法的值等于局面的值
+int runSelfPlay() {
+    std::vector<TicTacToeState> positions = openingPositions();
+    long long checks = 0, mismatches = 0;
+
+    for (const TicTacToeState& opening : positions) {
+        TicTacToeState state = opening;
+        while (!state.isTerminal()) {
+            for (int depth = 1; depth <= 9; depth++) {
+                SearchStats stats;
+                TicTacToeState s = state;
+                int expected = ENGINES[0].run(s, depth, stats);
+                for (int e = 1; e < ENGINE_COUNT; e++) {
+                    if (ENGINES[e].reset) {
+                        ENGINES[e].reset();
+                    }
+                    int value = ENGINES[e].run(s, depth, stats);
+                    checks++;
+                    if (value != expected) {
+                        mismatches++;
+                        std::cout << "mismatch: " << boardString(state) << " depth " << depth << " "
+                                  << ENGINES[0].name << "=" << expected << " " << ENGINES[e].name << "=" << value
+                                  << std::endl;
+                    }
+                }
+            }
+
+            SearchStats stats;
+            std::string before = boardString(state);
+            int value = runMinimax(state, 9, stats);
+            auto [row, col] = findBestMove(state, 9);
+            state.makeMove(row, col);
+            int after = runMinimax(state, 9, stats);
+            checks++;
+            if (after != value) {
+                mismatches++;
+                std::cout << "mismatch: findBestMove played " << row << " " << col << " from "
+                          << before << ", value " << value << " -> " << after << std::endl;
+            }
+        }
+    }
+
+    std::cout << positions.size() << " openings, " << checks << " checks, " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--selfplay") == 0) {
+        return runSelfPlay();
+    }
+    return runBench();
+}
@@ -5,195 +5,78 @@
 #include <algorithm>
 #include <ctime>
 #include <string>
+#include <future>
+#include <memory>
+#include <chrono>
+#include "tictactoe.hpp"
 
 // 最终版本：优化并添加GUI实现可视化人机对战
 
-// 井字棋游戏状态
-class TicTacToeState {
-public:
-    char board[3][3]; // 棋盘
-    char currentPlayer; // 当前玩家 ('X' 或 'O')
+// 在后台线程上运行findBestMove的句柄
+// start启动搜索，ready轮询是否完成，get取结果，cancel通知搜索停止并等待线程退出
+// 同一时刻只允许一个搜索在跑（全局置换表不是线程安全的），所以start前总是先cancel
+class AISearch {
+private:
+    std::shared_ptr<SearchControl> control;
+    std::future<std::pair<int, int>> result;
 
-    // 构造函数，初始化空棋盘
-    TicTacToeState() {
-        // 初始化棋盘
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                board[i][j] = ' ';
-            }
-        }
-        currentPlayer = 'X'; // X先手
+public:
+    ~AISearch() {
+        cancel();
     }
 
-    // 复制构造函数
-    TicTacToeState(const TicTacToeState& other) {
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                board[i][j] = other.board[i][j];
-            }
-        }
-        currentPlayer = other.currentPlayer;
+    void start(TicTacToeState state, int depth) {
+        cancel();
+        control = std::make_shared<SearchControl>();
+        std::shared_ptr<SearchControl> ctrl = control;
+        result = std::async(std::launch::async, [state, depth, ctrl]() mutable {
+            return findBestMove(state, depth, ctrl.get());
+        });
     }
 
-    // 判断是否是终止状态
-    bool isTerminal() const {
-        // 检查是否有玩家获胜
-        if (checkWin('X') || checkWin('O')) {
-            return true;
-        }
-        
-        // 检查是否平局（棋盘已满）
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                if (board[i][j] == ' ') {
-                    return false; // 还有空位，游戏没有结束
-                }
-            }
-        }
-        
-        return true; // 棋盘已满，平局
+    // 改用MCTS搜索timeLimitMs毫秒，nodes()此时是模拟次数；mcts在搜索结束前不能被其他线程使用
+    void startMcts(TicTacToeState state, MctsEngine<TicTacToeState>& mcts, int timeLimitMs) {
+        cancel();
+        control = std::make_shared<SearchControl>();
+        std::shared_ptr<SearchControl> ctrl = control;
+        MctsEngine<TicTacToeState>* engine = &mcts;
+        result = std::async(std::launch::async, [state, engine, timeLimitMs, ctrl]() {
+            int move = engine->search(state, timeLimitMs, 0, &ctrl->cancelled, &ctrl->nodes).move;
+            return std::make_pair(move / 3, move % 3);
+        });
     }
 
-    // 检查玩家是否获胜
-    bool checkWin(char player) const {
-        // 检查行
-        for (int i = 0; i < 3; i++) {
-            if (board[i][0] == player && board[i][1] == player && board[i][2] == player) {
-                return true;
-            }
-        }
-        
-        // 检查列
-        for (int j = 0; j < 3; j++) {
-            if (board[0][j] == player && board[1][j] == player && board[2][j] == player) {
-                return true;
-            }
-        }
-        
-        // 检查对角线
-        if (board[0][0] == player && board[1][1] == player && board[2][2] == player) {
-            return true;
-        }
-        
-        if (board[0][2] == player && board[1][1] == player && board[2][0] == player) {
-            return true;
+    void cancel() {
+        if (result.valid()) {
+            control->cancelled = true;
+            result.wait();
+            result = std::future<std::pair<int, int>>();
         }
-        
-        return false;
     }
 
-    // 获取状态的评估值
-    int evaluate() const {
-        if (checkWin('X')) {
-            return 10; // X获胜，返回正分
-        } else if (checkWin('O')) {
-            return -10; // O获胜，返回负分
-        } else {
-            return 0; // 平局或者游戏未结束
-        }
+    bool running() const {
+        return result.valid();
     }
 
-    // 获取所有可能的后继状态
-    std::vector<TicTacToeState> getSuccessors() const {
-        std::vector<TicTacToeState> successors;
-        
-        // 遍历棋盘，找到所有空位
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
-                if (board[i][j] == ' ') {
-                    // 创建新状态
-                    TicTacToeState newState(*this);
-                    newState.board[i][j] = currentPlayer;
-                    newState.currentPlayer = (currentPlayer == 'X') ? 'O' : 'X'; // 切换玩家
-                    successors.push_back(newState);
-                }
-            }
-        }
-        
-        return successors;
+    bool ready() const {
+        return result.valid() && result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
     }
 
-    // 执行移动并返回移动是否有效
-    bool makeMove(int row, int col) {
-        if (row >= 0 && row < 3 && col >= 0 && col < 3 && board[row][col] == ' ') {
-            board[row][col] = currentPlayer;
-            currentPlayer = (currentPlayer == 'X') ? 'O' : 'X'; // 切换玩家
-            return true;
-        }
-        return false;
+    std::pair<int, int> get() {
+        return result.get();
     }
-};
 
-// 带Alpha-Beta剪枝的Minimax算法
-int minimaxAlphaBeta(const TicTacToeState& state, int depth, int alpha, int beta, bool maximizingPlayer) {
-    // 如果到达终止状态或深度限制，返回评估值
-    if (depth == 0 || state.isTerminal()) {
-        return state.evaluate();
+    int depthReached() const {
+        return control ? control->depthReached.load() : 0;
     }
 
-    if (maximizingPlayer) {
-        // 最大化玩家
-        int bestValue = std::numeric_limits<int>::min();
-        std::vector<TicTacToeState> successors = state.getSuccessors();
-        
-        for (auto& child : successors) {
-            int v = minimaxAlphaBeta(child, depth - 1, alpha, beta, false);
-            bestValue = std::max(bestValue, v);
-            alpha = std::max(alpha, bestValue);
-            if (beta <= alpha) {
-                break; // Beta剪枝
-            }
-        }
-        
-        return bestValue;
-    } else {
-        // 最小化玩家
-        int bestValue = std::numeric_limits<int>::max();
-        std::vector<TicTacToeState> successors = state.getSuccessors();
-        
-        for (auto& child : successors) {
-            int v = minimaxAlphaBeta(child, depth - 1, alpha, beta, true);
-            bestValue = std::min(bestValue, v);
-            beta = std::min(beta, bestValue);
-            if (beta <= alpha) {
-                break; // Alpha剪枝
-            }
-        }
-        
-        return bestValue;
+    long long nodes() const {
+        return control ? control->nodes.load() : 0;
     }
-}
+};
 
-// 找到最佳移动的位置（行、列）
-std::pair<int, int> findBestMove(TicTacToeState& state, int depth) {
-    int bestRow = -1;
-    int bestCol = -1;
-    int bestValue = std::numeric_limits<int>::min();
-    
-    // 遍历所有可能的移动
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (state.board[i][j] == ' ') {
-                // 尝试这个移动
-                TicTacToeState newState(state);
-                newState.board[i][j] = state.currentPlayer;
-                newState.currentPlayer = (state.currentPlayer == 'X') ? 'O' : 'X';
-                
-                // 评估这个移动
-                int moveValue = minimaxAlphaBeta(newState, depth - 1, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), false);
-                
-                // 如果这个移动比之前找到的最佳移动更好，则更新最佳移动
-                if (moveValue > bestValue) {
-                    bestValue = moveValue;
-                    bestRow = i;
-                    bestCol = j;
-                }
-            }
-        }
-    }
-    
-    return std::make_pair(bestRow, bestCol);
-}
+const int MCTS_LEVEL = 10;      // 难度按钮在1-9之后的一档
+const int MCTS_TIME_MS = 500;   // MCTS每步的搜索时间
 
 // 游戏类
 class TicTacToeGame {
@@ -208,12 +91,18 @@ private:
     sf::RectangleShape restartButton;
     sf::Text difficultyText;
     sf::RectangleShape difficultyButton;
-    int difficulty; // 难度等级（1-9，代表搜索深度）
+    int difficulty; // 难度等级（1-9，代表搜索深度；MCTS_LEVEL表示改用蒙特卡洛树搜索）
     bool gameOver;
     std::string gameStatus;
+    MctsEngine<TicTacToeState> mcts;
+    AISearch aiSearch;
+    sf::Clock aiClock;  // AI开始思考的时刻
+    int aiThinkTime;    // 最短思考时间（毫秒），搜索先完成也等到这个时间再落子
 
 public:
-    TicTacToeGame() : window(sf::VideoMode(600, 700), "Tic-Tac-Toe - Minimax AI"), difficulty(5), gameOver(false) {
+    TicTacToeGame() : window(sf::VideoMode(600, 700), "Tic-Tac-Toe - Minimax AI"), difficulty(5), gameOver(false), aiThinkTime(0) {
+        window.setFramerateLimit(60);
+
         // 创建默认字体
         font.loadFromFile("arial.ttf"); // 尝试加载Arial字体
         
@@ -229,6 +118,9 @@ public:
     }
 
     void initGame() {
+        // 取消上一局还没结束的搜索
+        aiSearch.cancel();
+
         // 重置游戏状态
         gameState = TicTacToeState();
         gameOver = false;
@@ -281,22 +173,48 @@ public:
         difficultyText.setFont(font);
         difficultyText.setCharacterSize(24);
         difficultyText.setPosition(335.0f, 610.0f);
-        difficultyText.setString("Difficulty: " + std::to_string(difficulty));
+        difficultyText.setString(difficultyLabel());
         difficultyText.setFillColor(sf::Color::White);
 
         // 如果AI是先手，让AI先走一步
         if (gameState.currentPlayer == 'X') {
-            makeAIMove();
+            startAIMove();
         }
     }
 
-    void makeAIMove() {
+    // 在后台启动AI搜索，主循环每帧通过updateAIMove轮询结果
+    void startAIMove() {
         // 添加思考时间的随机延迟，使游戏更自然
-        int thinkTime = 300 + (rand() % 500);
-        sf::sleep(sf::milliseconds(thinkTime));
-        
+        aiThinkTime = 300 + (rand() % 500);
+        aiClock.restart();
+        if (difficulty == MCTS_LEVEL) {
+            aiSearch.startMcts(gameState, mcts, MCTS_TIME_MS);
+        } else {
+            aiSearch.start(gameState, difficulty);
+        }
+    }
+
+    std::string difficultyLabel() const {
+        return "Difficulty: " + (difficulty == MCTS_LEVEL ? std::string("MCTS") : std::to_string(difficulty));
+    }
+
+    void updateAIMove() {
+        if (!aiSearch.running()) {
+            return;
+        }
+
+        if (!aiSearch.ready() || aiClock.getElapsedTime().asMilliseconds() < aiThinkTime) {
+            if (difficulty == MCTS_LEVEL) {
+                gameStatus = "AI thinking... " + std::to_string(aiSearch.nodes()) + " playouts";
+            } else {
+                gameStatus = "AI thinking... depth " + std::to_string(aiSearch.depthReached()) +
+                             ", " + std::to_string(aiSearch.nodes()) + " nodes";
+            }
+            return;
+        }
+
+        auto [bestRow, bestCol] = aiSearch.get();
         if (!gameOver) {
-            auto [bestRow, bestCol] = findBestMove(gameState, difficulty);
             gameState.makeMove(bestRow, bestCol);
             updateGridText();
             
@@ -308,7 +226,7 @@ public:
     void updateGridText() {
         for (int i = 0; i < 3; i++) {
             for (int j = 0; j < 3; j++) {
-                if (gameState.board[i][j] == 'X') {
+                if (gameState.at(i, j) == 'X') {
                     gridText[i][j].setString("X");
                     gridText[i][j].setFillColor(sf::Color::Blue);
                     // 调整X的位置，使其居中
@@ -316,7 +234,7 @@ public:
                         grid[i][j].getPosition().x + grid[i][j].getSize().x/2 - 25,
                         grid[i][j].getPosition().y + grid[i][j].getSize().y/2 - 40
                     );
-                } else if (gameState.board[i][j] == 'O') {
+                } else if (gameState.at(i, j) == 'O') {
                     gridText[i][j].setString("O");
                     gridText[i][j].setFillColor(sf::Color::Red);
                     // 调整O的位置，使其居中
@@ -352,8 +270,13 @@ public:
         
         // 处理难度按钮点击
         if (difficultyButton.getGlobalBounds().contains(x, y)) {
-            difficulty = (difficulty % 9) + 1; // 循环 1-9
-            difficultyText.setString("Difficulty: " + std::to_string(difficulty));
+            difficulty = (difficulty % MCTS_LEVEL) + 1; // 循环 1-9、MCTS
+            difficultyText.setString(difficultyLabel());
+
+            // AI正在思考时按新的难度重新搜索
+            if (aiSearch.running()) {
+                startAIMove();
+            }
             return;
         }
         
@@ -365,7 +288,7 @@ public:
         // 检查玩家点击的是哪个格子
         for (int i = 0; i < 3; i++) {
             for (int j = 0; j < 3; j++) {
-                if (grid[i][j].getGlobalBounds().contains(x, y) && gameState.board[i][j] == ' ') {
+                if (grid[i][j].getGlobalBounds().contains(x, y) && gameState.at(i, j) == ' ') {
                     // 执行玩家移动
                     gameState.makeMove(i, j);
                     updateGridText();
@@ -375,7 +298,7 @@ public:
                     
                     // 如果游戏没有结束，让AI移动
                     if (!gameOver) {
-                        makeAIMove();
+                        startAIMove();
                     }
                     return;
                 }
@@ -402,6 +325,9 @@ public:
                 }
             }
             
+            // 检查后台搜索是否完成
+            updateAIMove();
+
             // 更新状态文本
             statusText.setString(gameStatus);
             
@@ -6,10 +6,10 @@
 //* 新增头文件
 #include <cmath>
 #include <cstring>
-#include <queue>
 #include <algorithm>
 #include <unordered_set>
 #include <climits>
+#include <ctime>
 
 using namespace std;
 
@@ -384,24 +384,288 @@ namespace Utils
       
         return true;
     }
+}
 
-    // 将坐标转化为string (用于拐角检测)
-    string idx2str(const pair<int, int> idx)
-    {
-        string a = to_string(idx.first);
-        if (a.length() == 1) a = "0" + a;
-        string b = to_string(idx.second);
-        if (b.length() == 1) b = "0" + b;
-        return a + b;
+// 网格搜索共用的临时数组，文件里所有的BFS和A*都用它记录访问标记、距离和前驱，整张表只有30x40格。
+// visit_stamp[y][x] == search_stamp 表示该格在本次搜索中已访问，开始新的搜索只需把 search_stamp 加一，不用清空数组。
+// 同一时刻只能有一个搜索在用这些数组，搜索过程中不能调用其他搜索函数
+namespace Scratch
+{
+    int visit_stamp[MAXM][MAXN];
+    int search_stamp = 0;
+    int dist[MAXM][MAXN];         // BFS的层数或A*的g值
+    Point parent[MAXM][MAXN];     // A*的前驱
+    Point queue_buf[MAXM * MAXN]; // BFS队列，搜索结束后[0, 队尾)就是访问过的全部格子
+
+    // 开始一次新的搜索
+    void begin() { search_stamp++; }
+
+    bool visited(int y, int x) { return visit_stamp[y][x] == search_stamp; }
+
+    // 标记为已访问并记录距离
+    void mark(int y, int x, int d) { visit_stamp[y][x] = search_stamp; dist[y][x] = d; }
+}
+
+// 距离场中到不了的格子
+constexpr int DIST_UNREACHABLE = INT_MAX / 4;
+
+// 每tick在judge()开头计算一次的距离场：从每条蛇的蛇头出发，求到全图各格的最小代价路线。
+// 墙和其他蛇的蛇身不可通过，自己的蛇身可以穿过（规则中与自己身体碰撞无影响），但第一步不能掉头回到蛇颈；
+// 进入陷阱代价+3，我方路线经过敌方蛇头下一步可能到达的格子代价+2（与A*寻路的代价一致）。
+// 评估函数用它O(1)查询"某条蛇到某格要走几步"，不再各自搜索或用曼哈顿距离估计
+struct DistanceFields {
+    // 计算所有蛇的距离场，fields下标与state.snakes一致
+    void build(const GameState &state) {
+        memset(body_owner, -1, sizeof(body_owner));
+        for (size_t i = 0; i < state.snakes.size(); i++) {
+            for (const auto &part : state.snakes[i].body) {
+                if (Utils::boundCheck(part.y, part.x)) body_owner[part.y][part.x] = i;
+            }
+        }
+
+        fields.resize(state.snakes.size());
+        ids.clear();
+        for (size_t i = 0; i < state.snakes.size(); i++) {
+            const auto &snake = state.snakes[i];
+            ids.push_back(snake.id);
+            search(fields[i], snake, i);
+        }
+        self_idx = state.self_idx;
+        ready = true;
     }
 
-    // 将string转化为坐标
-    pair<int, int> str2idx(const string &str)
-    {
-        string substr1{str[0], str[1]};
-        string substr2{str[2], str[3]};
-        return make_pair(stoi(substr1), stoi(substr2));
+    bool isReady() const { return ready; }
+
+    // 第snake_idx条蛇沿最小代价路线到达(y, x)要走的步数，到不了时为DIST_UNREACHABLE
+    int steps(int snake_idx, int y, int x) const {
+        const Field &f = fields[snake_idx];
+        return f.cost[y][x] == DIST_UNREACHABLE ? DIST_UNREACHABLE : f.steps[y][x];
+    }
+
+    int selfSteps(int y, int x) const { return steps(self_idx, y, x); }
+
+    // 蛇snake到p的步数，到不了（或距离场未计算）时退回曼哈顿距离，用于只需要比较远近的评分
+    int distance(const Snake &snake, const Point &p) const {
+        int manhattan = abs(snake.get_head().y - p.y) + abs(snake.get_head().x - p.x);
+        if (!ready || !Utils::boundCheck(p.y, p.x)) return manhattan;
+        for (size_t i = 0; i < ids.size(); i++) {
+            if (ids[i] == snake.id) {
+                int d = steps(i, p.y, p.x);
+                return d == DIST_UNREACHABLE ? manhattan : d;
+            }
+        }
+        return manhattan;
+    }
+
+    int selfDistance(const GameState &state, const Point &p) const { return distance(state.get_self(), p); }
+
+    // 第snake_idx条蛇能否进入(y, x)：墙和其他蛇的蛇身不能进入
+    bool passable(int y, int x, int snake_idx) const {
+        return Utils::boundCheck(y, x) && map_item[y][x] != -4 &&
+               (body_owner[y][x] < 0 || body_owner[y][x] == snake_idx);
+    }
+
+    // 从我方蛇头到target的最小代价路线（不含起点），到不了时为空
+    vector<Point> selfPath(const Point &target) const {
+        vector<Point> path;
+        const Field &f = fields[self_idx];
+        if (!Utils::boundCheck(target.y, target.x) || f.cost[target.y][target.x] == DIST_UNREACHABLE) return path;
+        for (Point p = target; f.cost[p.y][p.x] > 0; p = f.parent[p.y][p.x]) path.push_back(p);
+        reverse(path.begin(), path.end());
+        return path;
+    }
+
+private:
+    struct Field {
+        int cost[MAXM][MAXN];     // 最小代价
+        int steps[MAXM][MAXN];    // 最小代价路线的步数
+        Point parent[MAXM][MAXN]; // 最小代价路线上的前一格
+    };
+
+    vector<Field> fields;
+    vector<int> ids;
+    int self_idx = 0;
+    bool ready = false;
+    int body_owner[MAXM][MAXN]; // 占据该格的蛇在state.snakes中的下标，-1表示没有蛇身
+
+    // 进入(y, x)的代价
+    static int stepCost(int y, int x, bool is_self) {
+        int cost = 1;
+        if (map_item[y][x] == -2) cost += 3;              // 陷阱
+        if (is_self && map_snake[y][x] == -6) cost += 2;  // 敌方蛇头威胁区域
+        return cost;
+    }
+
+
+    // 单源最短路。边的代价只有1到6，用按代价分桶的队列（Dial算法），比堆快
+    void search(Field &f, const Snake &snake, int snake_idx) {
+        const Point &source = snake.get_head();
+        bool is_self = snake.id == MYID;
+        const int BUCKETS = 8; // 大于最大边代价即可循环使用
+        static vector<Point> buckets[BUCKETS];
+        for (auto &b : buckets) b.clear();
+        fill(&f.cost[0][0], &f.cost[0][0] + MAXM * MAXN, DIST_UNREACHABLE);
+        if (!Utils::boundCheck(source.y, source.x)) return;
+
+        f.cost[source.y][source.x] = 0;
+        f.steps[source.y][source.x] = 0;
+        f.parent[source.y][source.x] = source;
+        buckets[0].push_back(source);
+        int pending = 1;
+
+        for (int d = 0; pending > 0; d++) {
+            vector<Point> &bucket = buckets[d % BUCKETS];
+            for (size_t i = 0; i < bucket.size(); i++) {
+                const Point p = bucket[i];
+                pending--;
+                if (f.cost[p.y][p.x] != d) continue; // 已有更短的路线
+
+                for (auto dir : validDirections) {
+                    const auto [ny, nx] = Utils::nextPos({p.y, p.x}, dir);
+                    if (!passable(ny, nx, snake_idx)) continue;
+                    if (d == 0 && snake.body.size() > 1 && snake.body[1] == Point{ny, nx}) continue; // 不能掉头
+
+                    int c = d + stepCost(ny, nx, is_self);
+                    if (c < f.cost[ny][nx]) {
+                        f.cost[ny][nx] = c;
+                        f.steps[ny][nx] = f.steps[p.y][p.x] + 1;
+                        f.parent[ny][nx] = p;
+                        buckets[c % BUCKETS].push_back({ny, nx});
+                        pending++;
+                    }
+                }
+            }
+            bucket.clear();
+        }
+    }
+};
+
+// 本tick的距离场
+DistanceFields distance_fields;
+
+// 按距离场划分的地盘（Voronoi划分）：每格归最先到达的蛇，几条蛇同时最先到达的格子是争夺格，并统计每条蛇独占的格子数；
+// 每格还记录最快的敌方蛇、比我们先到和同时到的敌方蛇数，目标选择直接查表判断"我们能不能先到"
+struct Territory {
+    static constexpr int NOBODY = -1;    // 谁都到不了
+    static constexpr int CONTESTED = -2; // 几条蛇同时最先到达
+
+    // 在distance_fields计算完之后调用
+    void build(const GameState &state, const DistanceFields &fields) {
+        self_idx = state.self_idx;
+        head = state.get_self().get_head();
+        areas.assign(state.snakes.size(), 0);
+
+        for (int y = 0; y < MAXM; y++) {
+            for (int x = 0; x < MAXN; x++) {
+                Cell &c = cells[y][x];
+                c = {NOBODY, fields.steps(self_idx, y, x), DIST_UNREACHABLE, -1, 0, 0, 0};
+                int first = DIST_UNREACHABLE, first_count = 0;
+                for (int i = 0; i < (int)state.snakes.size(); i++) {
+                    int d = fields.steps(i, y, x);
+                    if (d == DIST_UNREACHABLE) continue;
+                    if (d < first) { first = d; first_count = 1; c.owner = i; }
+                    else if (d == first) first_count++;
+
+                    if (i == self_idx) continue;
+                    if (d < c.enemy_steps) { c.enemy_steps = d; c.closest_enemy = i; }
+                    if (d < c.my_steps) c.ahead++;
+                    else if (d == c.my_steps) c.tied++;
+                    if (d >= c.my_steps && d <= c.my_steps + 2) c.close++;
+                }
+                if (first_count > 1) c.owner = CONTESTED;
+                else if (c.owner >= 0) areas[c.owner]++;
+            }
+        }
+    }
+
+    // 格子归属：最先到达的蛇在state.snakes中的下标，或NOBODY/CONTESTED
+    int owner(const Point &p) const { return cells[p.y][p.x].owner; }
+    bool isMine(const Point &p) const { return owner(p) == self_idx; }
+    bool isContested(const Point &p) const { return owner(p) == CONTESTED; }
+
+    // 第snake_idx条蛇独占的格子数，争夺格不算任何一方的
+    int area(int snake_idx) const { return areas[snake_idx]; }
+    int myArea() const { return areas[self_idx]; }
+
+    // 最快的敌方蛇到p的步数和它的下标，没有敌方蛇到得了时分别为DIST_UNREACHABLE和-1
+    int enemySteps(const Point &p) const { return cells[p.y][p.x].enemy_steps; }
+    int closestEnemy(const Point &p) const { return cells[p.y][p.x].closest_enemy; }
+
+    // 比我们先到 / 和我们同时到 / 和我们同时或最多晚2步到 的敌方蛇数
+    int enemiesAhead(const Point &p) const { return cells[p.y][p.x].ahead; }
+    int enemiesTied(const Point &p) const { return cells[p.y][p.x].tied; }
+    int enemiesClose(const Point &p) const { return cells[p.y][p.x].close; }
+
+    // 这一步走到next之后我们独占的格子数：从next出发BFS，只数比所有敌方蛇都先到的格子，
+    // 敌方蛇先到或同时到的格子不再往外扩展
+    int areaAfterMove(const DistanceFields &fields, const Point &next) const {
+        if (!fields.passable(next.y, next.x, self_idx)) return 0;
+        int result = 0;
+        Scratch::begin();
+        Point *q = Scratch::queue_buf;
+        int q_head = 0, q_tail = 0;
+        q[q_tail++] = next;
+        Scratch::mark(next.y, next.x, 1);
+        while (q_head < q_tail) {
+            const Point p = q[q_head++];
+            int d = Scratch::dist[p.y][p.x];
+            if (d >= cells[p.y][p.x].enemy_steps) continue;
+            result++;
+            for (auto dir : validDirections) {
+                const auto [ny, nx] = Utils::nextPos({p.y, p.x}, dir);
+                if (!fields.passable(ny, nx, self_idx) || Scratch::visited(ny, nx)) continue;
+                Scratch::mark(ny, nx, d + 1);
+                q[q_tail++] = {ny, nx};
+            }
+        }
+        return result;
+    }
+
+    // 能否在物品消失前到达（lifetime为-1表示物品不会消失）。
+    // 距离场到不了的格子（例如暂时被敌方蛇身挡住）不直接丢弃，按原来的曼哈顿距离估计判断
+    bool reachableBeforeExpiry(const Item &item) const {
+        if (item.lifetime < 0) return true;
+        int steps = cells[item.pos.y][item.pos.x].my_steps;
+        if (steps == DIST_UNREACHABLE) {
+            return Utils::canReachFoodInTime(head.y, head.x, item.pos.y, item.pos.x, item.lifetime);
+        }
+        return steps < item.lifetime;
     }
+
+private:
+    struct Cell {
+        int owner;
+        int my_steps;
+        int enemy_steps;
+        int closest_enemy;
+        int ahead, tied, close;
+    };
+
+    Cell cells[MAXM][MAXN];
+    vector<int> areas;
+    int self_idx = 0;
+    Point head = {0, 0};
+};
+
+// 本tick的地盘划分
+Territory territory;
+
+// 每tick的CPU时间预算（毫秒）：平台限制为1秒CPU时间，剩下的留给进程启动、读入和输出。
+// 编译时可以用 -DCPU_BUDGET_MS=... 修改
+#ifndef CPU_BUDGET_MS
+#define CPU_BUDGET_MS 700
+#endif
+
+// 决策截止时间：main()一开始就计时，judge()据此决定还能不能继续细化决策
+namespace Deadline {
+    clock_t start_clock = 0;
+
+    void start() { start_clock = clock(); }
+
+    // 从start()起用掉的CPU时间
+    double elapsedMs() { return (double)(clock() - start_clock) * 1000.0 / CLOCKS_PER_SEC; }
+
+    bool expired() { return elapsedMs() >= CPU_BUDGET_MS; }
 }
 
 // 这行已移动到文件顶部，此处删除
@@ -1142,15 +1406,15 @@ namespace Strategy
     };
 
     // 检查敌方蛇是否在指定区域附近
-    bool checkEnemyNearArea(const GameState &state, const unordered_set<string>& area, int max_distance = 3) {
+    bool checkEnemyNearArea(const GameState &state, const Point *area, int area_size, int max_distance = 3) {
         for (const auto &snake : state.snakes) {
             if (snake.id != MYID && snake.id != -1) {
                 const Point &enemy_head = snake.get_head();
                 
                 // 检查敌方蛇头是否靠近区域中的任何点
-                for (const auto &point_str : area) {
-                    auto point = Utils::str2idx(point_str);
-                    int dist = abs(enemy_head.y - point.first) + abs(enemy_head.x - point.second);
+                for (int i = 0; i < area_size; i++) {
+                    const Point &point = area[i];
+                    int dist = abs(enemy_head.y - point.y) + abs(enemy_head.x - point.x);
                     if (dist <= max_distance) return true; // 发现敌方蛇在附近
                 }
             }
@@ -1163,44 +1427,38 @@ namespace Strategy
         TerrainAnalysis result;
         
         // 使用广度优先搜索，分析可到达区域的拓扑结构
-        unordered_set<string> visited;
-        queue<pair<pair<int, int>, int>> q; // 位置和距离
-        q.push({{y, x}, 0});
-        visited.insert(Utils::idx2str({y, x}));
+        Scratch::begin();
+        Point *q = Scratch::queue_buf; // 搜索结束后q[0, q_tail)就是可到达区域
+        int q_head = 0, q_tail = 0;
+        q[q_tail++] = {y, x};
+        Scratch::mark(y, x, 0);
         
         // 记录深度方向拓展和宽度方向拓展
         int max_depth = 0;
         int max_width = 0;
         int bottleneck_width = INT_MAX;
-        vector<vector<int>> reachable(MAXM, vector<int>(MAXN, -1));
         
         // 执行BFS
-        while (!q.empty()) {
-            auto [pos, depth] = q.front();
-            q.pop();
+        while (q_head < q_tail) {
+            const Point pos = q[q_head++];
+            int depth = Scratch::dist[pos.y][pos.x];
             
             max_depth = max(max_depth, depth);
-            reachable[pos.first][pos.second] = depth;
             
             // 检查四个方向
             for (auto dir : validDirections) {
-                const auto [ny, nx] = Utils::nextPos(pos, dir);
+                const auto [ny, nx] = Utils::nextPos({pos.y, pos.x}, dir);
                 
                 // 检查是否越界或者是障碍物
                 if (!Utils::boundCheck(ny, nx) || map_item[ny][nx] == -4 || map_snake[ny][nx] == -5) continue;
                 
-                string next = Utils::idx2str({ny, nx});
-                if (visited.find(next) == visited.end()) { visited.insert(next); q.push({{ny, nx}, depth + 1}); }
+                if (!Scratch::visited(ny, nx)) { Scratch::mark(ny, nx, depth + 1); q[q_tail++] = {ny, nx}; }
             }
         }
         
         // 统计每个深度的宽度
         vector<int> width_at_depth(max_depth + 1, 0);
-        for (int i = 0; i < MAXM; i++) {
-            for (int j = 0; j < MAXN; j++) {
-                if (reachable[i][j] >= 0) width_at_depth[reachable[i][j]]++;
-            }
-        }
+        for (int i = 0; i < q_tail; i++) width_at_depth[Scratch::dist[q[i].y][q[i].x]]++;
         
         // 计算最大宽度和瓶颈宽度
         for (int d = 0; d <= max_depth; d++) {
@@ -1209,7 +1467,7 @@ namespace Strategy
         }
         
         // 分析结果
-        result.exit_count = visited.size();
+        result.exit_count = q_tail;
         result.depth = max_depth;
         
         // 检测角落 - 增强型
@@ -1279,8 +1537,8 @@ namespace Strategy
         }
         
         // 检测死胡同：降低阈值，增加敏感度
-        if ((max_depth > 2 && max_width < 4 && visited.size() < 15) || // 更宽松条件，更早识别死胡同
-            (bottleneck_width <= 1 && visited.size() < 20)) { // 任何单格通道都视为潜在死胡同
+        if ((max_depth > 2 && max_width < 4 && q_tail < 15) || // 更宽松条件，更早识别死胡同
+            (bottleneck_width <= 1 && q_tail < 20)) { // 任何单格通道都视为潜在死胡同
             result.is_dead_end = true;
             result.risk_score -= 1200; // 增加基础惩罚(800->1200)
             
@@ -1301,9 +1559,8 @@ namespace Strategy
             bool enemies_near_exit = false;
             for (const auto &snake : state.snakes) {
                 if (snake.id != MYID && snake.id != -1) {
-                    for (const auto &point_str : visited) {
-                        auto point = Utils::str2idx(point_str);
-                        int dist = abs(snake.get_head().y - point.first) + abs(snake.get_head().x - point.second);
+                    for (int i = 0; i < q_tail; i++) {
+                        int dist = abs(snake.get_head().y - q[i].y) + abs(snake.get_head().x - q[i].x);
                         if (dist <= 3) {
                             enemies_near_exit = true;
                             break;
@@ -1323,15 +1580,14 @@ namespace Strategy
             result.risk_score -= 450 * (4 - bottleneck_width); // 增强基础惩罚(300->450)
             
             // 检查瓶颈附近是否有其他蛇
-            if (checkEnemyNearArea(state, visited, 4)) { // 增加检测范围(3->4)
+            if (checkEnemyNearArea(state, q, q_tail, 4)) { // 增加检测范围(3->4)
                 result.risk_score -= 800; // 增加敌方蛇惩罚(500->800)
             }
             
             // 检查瓶颈是否靠近地图边缘 - 这种情况特别危险
             bool near_edge = false;
-            for (const auto &point_str : visited) {
-                auto point = Utils::str2idx(point_str);
-                if (point.first <= 1 || point.first >= MAXM-2 || point.second <= 1 || point.second >= MAXN-2) {
+            for (int i = 0; i < q_tail; i++) {
+                if (q[i].y <= 1 || q[i].y >= MAXM-2 || q[i].x <= 1 || q[i].x >= MAXN-2) {
                     near_edge = true;
                     break;
                 }
@@ -1731,15 +1987,16 @@ namespace Strategy
         }
 
         // BFS搜索价值区域
-        unordered_set<string> visited;
-        queue<pair<string, int>> q;
-        string initial = Utils::idx2str(make_pair(sy, sx));
-        q.emplace(initial, 1);
-        visited.insert(initial);
-        
-        while (!q.empty()) {
-            auto [currentState, layer] = q.front();
-            q.pop();
+        Scratch::begin();
+        Point *q = Scratch::queue_buf;
+        int q_head = 0, q_tail = 0;
+        q[q_tail++] = {sy, sx};
+        Scratch::mark(sy, sx, 1);
+        
+        while (q_head < q_tail) {
+            // 当前位置和层数
+            const auto [y, x] = q[q_head++];
+            int layer = Scratch::dist[y][x];
             
             // 设定视野搜索范围
             double maxLayer = 12;
@@ -1747,15 +2004,12 @@ namespace Strategy
             
             if (layer >= maxLayer) break;
             
-            // 解析当前位置
-            const auto [y, x] = Utils::str2idx(currentState);
-            
             // 检查食物可达性
             bool can_reach = true;
             for (const auto &item : state.items) {
                 if (item.pos.y == y && item.pos.x == x) {
-                    // 使用通用的目标可达性检测函数
-                    if (!Utils::isTargetReachable(state, item.pos, item.lifetime)) {
+                    // 安全区收缩检测，以及能否在食物消失前到达
+                    if (!Utils::isTargetReachable(state, item.pos) || !territory.reachableBeforeExpiry(item)) {
                         can_reach = false;
                         break;
                     }
@@ -1765,10 +2019,9 @@ namespace Strategy
             // 获取食物基础价值
             int base_value = map_item[y][x];
             
-            // 计算到蛇头的距离
-                const auto &snake_head = state.get_self().get_head();
-                int head_dist = abs(snake_head.y - y) + abs(snake_head.x - x);
-                
+            // 计算蛇头到这里的步数
+            int head_dist = distance_fields.selfDistance(state, {y, x});
+            
             // 使用新的辅助函数评估食物价值
             double num = (map_item[y][x] != 0 && map_item[y][x] != -2 && !can_reach) ? 0 : 
                         evaluateFoodValue(state, y, x, base_value, head_dist);
@@ -1812,38 +2065,32 @@ namespace Strategy
             
             // 考虑竞争因素调整权重
             if (map_item[y][x] != -2) { // 不是陷阱
-                // 强化竞争因素评估
+                // 强化竞争因素评估 - 按地盘划分查比我们先到和几乎同时到的敌方蛇数
                 float competition_factor = 1.0f;
-                const auto &self_head = state.get_self().get_head();
-                int self_distance = abs(self_head.y - y) + abs(self_head.x - x);
+                int self_distance = head_dist;
+                int ahead = territory.enemiesAhead({y, x});
+                int close = territory.enemiesClose({y, x});
                 
-                // 检查其他蛇与目标的距离关系
-                for (const auto &snake : state.snakes) {
-                    if (snake.id != MYID && snake.id != -1) {
-                        int dist = abs(snake.get_head().y - y) + abs(snake.get_head().x - x);
-                    
-                        // 如果敌方蛇更近，竞争系数降低
-                        if (dist < self_distance) {
-                            // 对高价值尸体的竞争调整
-                            if (map_item[y][x] >= 10) { // 极高价值尸体
-                                competition_factor *= (self_distance <= 6) ? 0.95f : 0.85f;
-                            } else if (map_item[y][x] >= 5) { // 高价值尸体
-                                competition_factor *= (self_distance <= 4) ? 0.90f : 0.80f;
-                            } else {
-                                competition_factor *= 0.8f; // 从0.7提高到0.8，减轻普通食物竞争惩罚
-                            }
-                        }
-                        // 如果敌方蛇距离相近，轻微降低价值
-                        else if (dist <= self_distance + 2) {
-                            if (map_item[y][x] >= 8) { // 对高分尸体，竞争性调整
-                                competition_factor *= (self_distance <= 6) ? 0.98f : 0.95f;
-                            } else {
-                                competition_factor *= 0.9f; // 普通食物降低价值
-                            }
-                        }
-                    }
+                // 如果敌方蛇更近，竞争系数降低
+                float ahead_factor;
+                if (map_item[y][x] >= 10) { // 极高价值尸体
+                    ahead_factor = (self_distance <= 6) ? 0.95f : 0.85f;
+                } else if (map_item[y][x] >= 5) { // 高价值尸体
+                    ahead_factor = (self_distance <= 4) ? 0.90f : 0.80f;
+                } else {
+                    ahead_factor = 0.8f; // 从0.7提高到0.8，减轻普通食物竞争惩罚
                 }
                 
+                // 如果敌方蛇距离相近，轻微降低价值
+                float close_factor;
+                if (map_item[y][x] >= 8) { // 对高分尸体，竞争性调整
+                    close_factor = (self_distance <= 6) ? 0.98f : 0.95f;
+                } else {
+                    close_factor = 0.9f; // 普通食物降低价值
+                }
+                
+                competition_factor *= pow(ahead_factor, ahead) * pow(close_factor, close);
+                
                 // 应用竞争系数
                 weight *= competition_factor;
             }
@@ -1862,10 +2109,9 @@ namespace Strategy
                     if (layer == 1 && map_item[next_y][next_x] == -4) score -= 10; // 靠近墙的惩罚
                 } else {
                     // 加入待访问队列
-                    string neighbour = Utils::idx2str(make_pair(next_y, next_x));
-                    if (visited.find(neighbour) == visited.end()) {
-                        q.emplace(neighbour, layer + 1);
-                        visited.insert(neighbour);
+                    if (!Scratch::visited(next_y, next_x)) {
+                        Scratch::mark(next_y, next_x, layer + 1);
+                        q[q_tail++] = {next_y, next_x};
                     }
                 }
             }
@@ -2077,7 +2323,7 @@ namespace Strategy
         }
         
         const auto &head = state.get_self().get_head();
-        int distance = abs(head.y - target_pos.y) + abs(head.x - target_pos.x);
+        int distance = distance_fields.selfDistance(state, target_pos);
       
         // 基础评估
         TargetEvaluation result = {
@@ -2115,20 +2361,9 @@ namespace Strategy
             result.value *= 0.5;
         }
       
-        // 竞争因素
-        int closest_competitor_dist = INT_MAX;
-      
-        for (const auto &snake : state.snakes) {
-            if (snake.id != MYID && snake.id != -1) {
-                int enemy_dist = abs(snake.get_head().y - target_pos.y) + 
-                                abs(snake.get_head().x - target_pos.x);
-              
-                if (enemy_dist < distance) {
-                    closest_competitor_dist = min(closest_competitor_dist, enemy_dist);
-                    result.value *= 0.7; // 竞争惩罚
-                }
-            }
-        }
+        // 竞争因素：每条比我们先到的敌方蛇都有竞争惩罚；和敌方蛇同时最先到达的争夺格还有撞头的风险
+        result.value *= pow(0.7, territory.enemiesAhead(target_pos));
+        if (territory.isContested(target_pos)) result.value *= 0.85;
       
         return result;
     }
@@ -2136,7 +2371,7 @@ namespace Strategy
     // 专门评估宝箱和钥匙目标的价值和安全性
     TargetEvaluation evaluateChestKeyTarget(const GameState &state, const Point &target_pos, double base_value, bool is_chest) {
         const auto &head = state.get_self().get_head();
-        int distance = abs(head.y - target_pos.y) + abs(head.x - target_pos.x);
+        int distance = distance_fields.selfDistance(state, target_pos);
         const auto &self = state.get_self();
         
         // 基础评估
@@ -2199,27 +2434,12 @@ namespace Strategy
             }
         }
         
-        // 竞争因素 - 对宝箱和钥匙的竞争评估更加细致
-        vector<pair<int, int>> competitors; // 存储(距离, 蛇ID)
-        
-        for (const auto &snake : state.snakes) {
-            if (snake.id != MYID && snake.id != -1) {
-                const Point &enemy_head = snake.get_head();
-                int enemy_dist = abs(enemy_head.y - target_pos.y) + abs(enemy_head.x - target_pos.x);
-                
-                // 记录所有竞争者
-                if (enemy_dist <= distance * 1.5) { // 只考虑距离较近的竞争者
-                    competitors.push_back({enemy_dist, snake.id});
-                }
-            }
-        }
+        // 竞争因素 - 对宝箱和钥匙的竞争评估更加细致，竞争者是按地盘划分不比我们慢的敌方蛇
+        int competitors = territory.enemiesAhead(target_pos) + territory.enemiesTied(target_pos);
         
         // 根据竞争情况调整价值
-        if (!competitors.empty()) {
-            // 按距离排序
-            sort(competitors.begin(), competitors.end());
-            
-            int closest_competitor_dist = competitors[0].first;
+        if (competitors > 0) {
+            int closest_competitor_dist = territory.enemySteps(target_pos);
             
             // 如果敌人比我们更近
             if (closest_competitor_dist < distance) {
@@ -2257,8 +2477,8 @@ namespace Strategy
             }
             
             // 多个竞争者更加危险
-            if (competitors.size() > 1) {
-                result.value *= pow(0.9, competitors.size() - 1);
+            if (competitors > 1) {
+                result.value *= pow(0.9, competitors - 1);
             }
         }
         
@@ -2439,34 +2659,35 @@ namespace Strategy
     
     // A*寻路算法实现
     vector<Point> findPath(const GameState &state, const Point &start, const Point &target) {
+        // 从我方蛇头出发的寻路直接沿本tick的距离场回溯
+        if (distance_fields.isReady() && start == state.get_self().get_head()) {
+            return distance_fields.selfPath(target);
+        }
+        
         // 启发式函数：计算曼哈顿距离
         auto h = [](const Point &p, const Point &target) {
             return abs(p.y - target.y) + abs(p.x - target.x);
         };
         
-        // 优先队列用于A*算法，按f值（g+h）排序
-        // 存储格式：{f值, {g值, {点位置y, 点位置x}}}
-        priority_queue<pair<int, pair<int, Point>>, vector<pair<int, pair<int, Point>>>, greater<>> pq;
-        
-        // 记录已经访问的节点和每个点的前驱节点
-        unordered_map<string, bool> visited;
-        unordered_map<string, Point> parent;
+        // 小根堆作为A*的开放列表，按f值（g+h）排序
+        // 存储格式：{f值, {g值, 点位置}}；每个点当前最优的g值和前驱记录在Scratch数组里
+        static vector<pair<int, pair<int, Point>>> open_list;
+        open_list.clear();
         
         // 初始化起点
-        pq.push({h(start, target), {0, start}});
+        Scratch::begin();
+        Scratch::mark(start.y, start.x, 0);
+        open_list.push_back({h(start, target), {0, start}});
         
         // A*搜索
-        while (!pq.empty()) {
-            auto [f, gp] = pq.top();
+        while (!open_list.empty()) {
+            pop_heap(open_list.begin(), open_list.end(), greater<>());
+            auto [f, gp] = open_list.back();
             auto [g, current] = gp;
-            pq.pop();
-            
-            // 生成当前点的唯一标识
-            string current_id = Utils::idx2str({current.y, current.x});
+            open_list.pop_back();
             
-            // 如果已访问，跳过
-            if (visited[current_id]) continue;
-            visited[current_id] = true;
+            // 之后又找到了更短的路线，这条记录已过期，跳过
+            if (g > Scratch::dist[current.y][current.x]) continue;
             
             // 如果到达目标，构建路径并返回
             if (current.y == target.y && current.x == target.x) {
@@ -2474,8 +2695,7 @@ namespace Strategy
                 Point p = current;
                 while (!(p.y == start.y && p.x == start.x)) {
                     path.push_back(p);
-                    string p_id = Utils::idx2str({p.y, p.x});
-                    p = parent[p_id];
+                    p = Scratch::parent[p.y][p.x];
                 }
                 reverse(path.begin(), path.end());
                 return path;
@@ -2493,10 +2713,6 @@ namespace Strategy
                 
                 // 新的点
                 Point next = {ny, nx};
-                string next_id = Utils::idx2str({ny, nx});
-                
-                // 如果已访问，跳过
-                if (visited[next_id]) continue;
                 
                 // 计算新的g值（距离起点的成本）
                 int new_g = g + 1;
@@ -2507,12 +2723,17 @@ namespace Strategy
                 // 考虑蛇头威胁区域成本
                 if (map_snake[ny][nx] == -6) new_g += 2;
                 
+                // 已有不差于此的路线，跳过
+                if (Scratch::visited(ny, nx) && Scratch::dist[ny][nx] <= new_g) continue;
+                
                 // 计算f值（总估计成本）
                 int new_f = new_g + h(next, target);
                 
                 // 更新队列
-                pq.push({new_f, {new_g, next}});
-                parent[next_id] = current;
+                Scratch::mark(ny, nx, new_g);
+                Scratch::parent[ny][nx] = current;
+                open_list.push_back({new_f, {new_g, next}});
+                push_heap(open_list.begin(), open_list.end(), greater<>());
             }
         }
         
@@ -2527,25 +2748,26 @@ namespace Strategy
         int max_range = 3; // 检查周围3格范围内的开阔度
         
         // 使用BFS计算周围可达点数量
-        unordered_set<string> visited;
-        queue<pair<Point, int>> q;
-        q.push({point, 0});
-        visited.insert(Utils::idx2str({point.y, point.x}));
-        
-        while (!q.empty()) {
-            auto [curr, depth] = q.front(); q.pop();
-            if (depth > max_range) continue;
+        Scratch::begin();
+        Point *q = Scratch::queue_buf;
+        int q_head = 0, q_tail = 0;
+        q[q_tail++] = point;
+        Scratch::mark(point.y, point.x, 0);
+        
+        while (q_head < q_tail) {
+            const Point curr = q[q_head++];
+            int depth = Scratch::dist[curr.y][curr.x];
             
             open_cells++;
+            if (depth == max_range) continue; // 范围边缘的点不再扩展
             
             for (auto dir : validDirections) {
                 const auto [ny, nx] = Utils::nextPos({curr.y, curr.x}, dir);
-                string key = Utils::idx2str({ny, nx});
                 
                 if (Utils::boundCheck(ny, nx) && map_item[ny][nx] != -4 && map_snake[ny][nx] != -5 && 
-                    visited.find(key) == visited.end()) {
-                    q.push({{ny, nx}, depth + 1});
-                    visited.insert(key);
+                    !Scratch::visited(ny, nx)) {
+                    Scratch::mark(ny, nx, depth + 1);
+                    q[q_tail++] = {ny, nx};
                 }
             }
         }
@@ -3116,13 +3338,13 @@ bool enhancedFoodProcessByPriority(const GameState &state, int minValue, int max
         }
         
         // 计算距离
-            int dist = abs(head.y - item.pos.y) + abs(head.x - item.pos.x);
+        int dist = distance_fields.selfDistance(state, item.pos);
         if (dist > maxRange) {
             continue;  // 跳过超出范围的食物
         }
         
-        // 使用通用的目标可达性检测
-        if (!Utils::isTargetReachable(state, item.pos, item.lifetime)) {
+        // 安全区收缩检测，以及能否在食物消失前到达
+        if (!Utils::isTargetReachable(state, item.pos) || !territory.reachableBeforeExpiry(item)) {
             continue; // 跳过不可达的食物
         }
         
@@ -3183,29 +3405,23 @@ bool enhancedFoodProcessByPriority(const GameState &state, int minValue, int max
         if (dist == 1) distance_factor *= 1.8; // 紧邻食物(dist=1)显著提升权重
         double cluster_bonus = nearby_food_count * 0.15; // 食物密集区加分
         
-        // 3. 改进: 竞争分析
+        // 3. 改进: 竞争分析 - 按地盘划分，不比我们慢的敌方蛇才是竞争者
         double competition_penalty = 0;
+        int rivals = territory.enemiesAhead(item.pos) + territory.enemiesTied(item.pos);
         
         // 紧邻食物无竞争惩罚，确保优先获取
-        if (dist == 1) {
-            competition_penalty = 0;
-        } else {
-            for (const auto &snake : state.snakes) {
-                if (snake.id != MYID && snake.id != -1) {
-                    int enemy_dist = abs(snake.get_head().y - item.pos.y) + abs(snake.get_head().x - item.pos.x);
-                    if (enemy_dist < dist * 1.2) { // 敌蛇更近或距离相近
-                    // 评估我方蛇在竞争中的优势
-                    bool has_length_advantage = self.length > snake.length + 2;
-                    bool has_position_advantage = Strategy::countSafeExits(state, item.pos) >= 2;
-                    
-                    // 根据优势调整惩罚
-                    if (!has_length_advantage && !has_position_advantage)
-                        competition_penalty += 0.4; // 重大劣势
-                    else if (has_length_advantage || has_position_advantage)
-                        competition_penalty += 0.2; // 部分劣势
-                }
-            }
-        }
+        if (dist != 1 && rivals > 0) {
+            // 评估我方蛇相对最快竞争者的优势
+            const Snake &rival = state.snakes[territory.closestEnemy(item.pos)];
+            bool has_length_advantage = self.length > rival.length + 2;
+            bool has_position_advantage = Strategy::countSafeExits(state, item.pos) >= 2 ||
+                                          territory.myArea() > territory.area(territory.closestEnemy(item.pos));
+            
+            // 根据优势调整惩罚
+            if (!has_length_advantage && !has_position_advantage)
+                competition_penalty = 0.4 * rivals; // 重大劣势
+            else
+                competition_penalty = 0.2 * rivals; // 部分劣势
         }
         
         // 应用竞争惩罚
@@ -3346,8 +3562,12 @@ bool processFoodWithDynamicPriority(const GameState &state, Direction& moveDirec
 int handleInitialShieldPhase(const GameState &state, int current_tick);
 
 // 修改judge函数，整合所有安全性改进
-int judge(const GameState &state)
+int judgeByHeuristics(const GameState &state)
 {
+    // 本tick所有评估共用的距离场和地盘划分
+    distance_fields.build(state);
+    territory.build(state, distance_fields);
+    
     // 更新目标锁定状态
     lock_on_target(state);
     
@@ -3690,7 +3910,7 @@ bool processFoodWithDynamicPriority(const GameState &state, Direction& moveDirec
         if (item.value == -2) continue; // 跳过陷阱
         
         // 计算距离
-        int dist = abs(head.y - item.pos.y) + abs(head.x - item.pos.x);
+        int dist = distance_fields.selfDistance(state, item.pos);
         int effective_max_range = 12; // 默认最大搜索范围
         
         // 适度扩大尸体搜索范围
@@ -3707,8 +3927,8 @@ bool processFoodWithDynamicPriority(const GameState &state, Direction& moveDirec
         
         if (dist > effective_max_range) continue; // 应用调整后的搜索范围
         
-        // 使用通用的目标可达性检测
-        if (!Utils::isTargetReachable(state, item.pos, item.lifetime)) {
+        // 安全区收缩检测，以及能否在食物消失前到达
+        if (!Utils::isTargetReachable(state, item.pos) || !territory.reachableBeforeExpiry(item)) {
             continue; // 跳过不可达的食物
         }
         
@@ -3821,67 +4041,62 @@ bool processFoodWithDynamicPriority(const GameState &state, Direction& moveDirec
         if (dist == 1) distance_factor *= 1.8; // 紧邻食物(dist=1)显著提升权重
         double cluster_bonus = nearby_food_count * 0.15; // 食物密集区加分
         
-        // 3. 改进: 竞争分析 - 对尸体优化竞争评估
+        // 3. 改进: 竞争分析 - 对尸体优化竞争评估，按地盘划分和最快的敌方蛇比较
         double competition_penalty = 0;
-        for (const auto &snake : state.snakes) {
-            if (snake.id != MYID && snake.id != -1) {
-                int enemy_dist = abs(snake.get_head().y - item.pos.y) + abs(snake.get_head().x - item.pos.x);
+        int closest = territory.closestEnemy(item.pos);
+        int rivals = territory.enemiesAhead(item.pos) + territory.enemiesTied(item.pos);
+        
+        if (closest >= 0) {
+            const Snake &rival = state.snakes[closest];
+          
+            // 针对尸体的特殊竞争评估；紧邻尸体无竞争惩罚，确保优先获取
+            if (item.value > 0 && dist != 1) {
+                // 计算距离差异 - 正值表示我们更近
+                int distance_advantage = territory.enemySteps(item.pos) - dist;
               
-                // 针对尸体的特殊竞争评估
-                if (item.value > 0) { // 尸体
-                    // 紧邻尸体无竞争惩罚，确保优先获取
-                    if (dist == 1) {
-                        competition_penalty = 0; 
-                        continue; // 跳过后续竞争评估
-                    }
-                    // 计算距离差异 - 正值表示我们更近
-                    int distance_advantage = enemy_dist - dist;
-                  
-                    // 评估优势因素
-                    bool has_length_advantage = self.length >= snake.length;
-                    bool has_shield_advantage = self.shield_time > 0 && self.shield_time >= 3;
-                    bool is_high_value = item.value >= 8;
-                  
-                    // 如果我方更近或距离相近
-                    if (distance_advantage >= 0) {
-                        // 我方占优，几乎不惩罚
-                        competition_penalty += 0.05;
-                    }
-                    // 敌方略微更近
-                    else if (distance_advantage >= -2) {
-                        // 如果有优势或尸体价值高，适度惩罚
-                        if (has_length_advantage || has_shield_advantage || is_high_value) {
-                            competition_penalty += 0.15;
-                        } else {
-                            competition_penalty += 0.3;
-                        }
-                    }
-                    // 敌方明显更近
-                    else if (distance_advantage >= -4) {
-                        // 如果同时具有长度和护盾优势，或是极高价值尸体，仍然考虑争夺
-                        if ((has_length_advantage && has_shield_advantage) || item.value >= 10) {
-                            competition_penalty += 0.4;
-                        } else {
-                            competition_penalty += 0.6;
-                        }
-                    }
-                    // 敌方远远更近，几乎放弃
-                    else {
-                        competition_penalty += 0.8;
+                // 评估优势因素
+                bool has_length_advantage = self.length >= rival.length;
+                bool has_shield_advantage = self.shield_time > 0 && self.shield_time >= 3;
+                bool is_high_value = item.value >= 8;
+              
+                // 如果我方更近或距离相近
+                if (distance_advantage >= 0) {
+                    // 我方占优，几乎不惩罚
+                    competition_penalty = 0.05;
+                }
+                // 敌方略微更近
+                else if (distance_advantage >= -2) {
+                    // 如果有优势或尸体价值高，适度惩罚
+                    if (has_length_advantage || has_shield_advantage || is_high_value) {
+                        competition_penalty = 0.15;
+                    } else {
+                        competition_penalty = 0.3;
                     }
-                } else { // 非尸体食物保持原有逻辑
-                    if (enemy_dist < dist * 1.2) { // 敌蛇更近或距离相近
-                        // 评估我方蛇在竞争中的优势
-                        bool has_length_advantage = self.length > snake.length + 2;
-                        bool has_position_advantage = Strategy::countSafeExits(state, item.pos) >= 2;
-                      
-                        // 根据优势调整惩罚
-                        if (!has_length_advantage && !has_position_advantage)
-                            competition_penalty += 0.4; // 重大劣势
-                        else if (has_length_advantage || has_position_advantage)
-                            competition_penalty += 0.2; // 部分劣势
+                }
+                // 敌方明显更近
+                else if (distance_advantage >= -4) {
+                    // 如果同时具有长度和护盾优势，或是极高价值尸体，仍然考虑争夺
+                    if ((has_length_advantage && has_shield_advantage) || item.value >= 10) {
+                        competition_penalty = 0.4;
+                    } else {
+                        competition_penalty = 0.6;
                     }
                 }
+                // 敌方远远更近，几乎放弃
+                else {
+                    competition_penalty = 0.8;
+                }
+            } else if (item.value <= 0 && rivals > 0) { // 非尸体食物
+                // 评估我方蛇在竞争中的优势
+                bool has_length_advantage = self.length > rival.length + 2;
+                bool has_position_advantage = Strategy::countSafeExits(state, item.pos) >= 2 ||
+                                              territory.myArea() > territory.area(closest);
+              
+                // 根据优势调整惩罚
+                if (!has_length_advantage && !has_position_advantage)
+                    competition_penalty = 0.4 * rivals; // 重大劣势
+                else
+                    competition_penalty = 0.2 * rivals; // 部分劣势
             }
         }
         
@@ -4154,31 +4369,31 @@ int handleInitialShieldPhase(const GameState &state, int current_tick) {
           
             // 计算空旷度 - 从该点BFS探索几步，计算可达点的数量
             double openness = 0;
-            unordered_set<string> visited;
-            queue<pair<pair<int, int>, int>> q; // 位置和距离
-            q.push({{ny, nx}, 1});
-            visited.insert(Utils::idx2str({ny, nx}));
+            Scratch::begin();
+            Point *q = Scratch::queue_buf;
+            int q_head = 0, q_tail = 0;
+            q[q_tail++] = {ny, nx};
+            Scratch::mark(ny, nx, 1);
           
-            while (!q.empty()) {
-                auto [pos, depth] = q.front();
-                q.pop();
-              
-                if (depth > 4) continue; // 只探索4步以内
+            while (q_head < q_tail) {
+                const Point pos = q[q_head++];
+                int depth = Scratch::dist[pos.y][pos.x];
               
                 // 深度越浅的点贡献越大
                 openness += (5 - depth) * 0.5;
               
+                if (depth == 4) continue; // 只探索4步以内
+              
                 // 继续探索
                 for (auto next_dir : validDirections) {
-                    const auto [next_y, next_x] = Utils::nextPos(pos, next_dir);
-                    string key = Utils::idx2str({next_y, next_x});
+                    const auto [next_y, next_x] = Utils::nextPos({pos.y, pos.x}, next_dir);
                   
                     if (Utils::boundCheck(next_y, next_x) && 
                         map_item[next_y][next_x] != -4 && // 不是墙
-                        visited.find(key) == visited.end()) { // 未访问过
+                        !Scratch::visited(next_y, next_x)) { // 未访问过
                       
-                        q.push({{next_y, next_x}, depth + 1});
-                        visited.insert(key);
+                        Scratch::mark(next_y, next_x, depth + 1);
+                        q[q_tail++] = {next_y, next_x};
                     }
                 }
             }
@@ -4240,7 +4455,331 @@ int handleInitialShieldPhase(const GameState &state, int current_tick) {
     return Utils::dir2num(chooseBestDirection(state));
 }
 
+// 生存前瞻：逐步推演局面，用逐步加深的DFS给每个第一步打分。
+// 每走一步，所有蛇的蛇尾都往前缩一格（蛇身格子在它离蛇尾的距离那么多步后空出来），
+// 敌方蛇头能到的范围每步向外扩一格（按蛇尾回缩算出每格敌方蛇头最早能到的步数），敌方蛇不比我们晚到的格子在它经过时不能进入。
+// 与自己的身体碰撞无影响，所以我们的蛇身不算障碍，只是不能掉头走回蛇颈；陷阱只扣分，也不算障碍。
+// 蛇自己的身体不挡自己，所以局面只由蛇头、来的方向和步数决定，置换表按这三者记录，失败的分支不会重复搜索
+namespace Lookahead {
+    constexpr int MAX_DEPTH = 100;       // 前瞻的最大步数
+    constexpr int CHECK_INTERVAL = 1024; // 每搜索这么多结点检查一次截止时间（必须是2的幂）
+    constexpr int TRAP_PENALTY = 10;     // 踩陷阱扣10分，按少10格空间算
+    constexpr int DEAD = INT_MIN / 2;    // 第k步无路可走的分支得分为DEAD + k，比任何活着的分支都低
+
+    int self_idx = 0;
+    int self_length = 0;
+    int space_limit = 0;        // 叶子结点最多数这么多格空间
+    int shrink_step = INT_MAX;  // 从第几步起安全区按下次收缩后的范围算
+    int final_step = INT_MAX;   // 从第几步起安全区按最终范围算
+    long long nodes = 0;
+    bool out_of_time = false;
+
+    int vacate_at[MAXM][MAXN];    // 蛇身格子从第几步起空出来
+    int vacate_owner[MAXM][MAXN]; // 占据该格的蛇在state.snakes中的下标，-1表示没有蛇身
+    int self_reach[MAXM][MAXN];   // 我方蛇头最早第几步能到，到不了时为DIST_UNREACHABLE
+    int enemy_reach[MAXM][MAXN];  // 敌方蛇头最早第几步能到，到不了时为DIST_UNREACHABLE
+    int reach_length[MAXM][MAXN]; // 最早到达的敌方蛇的长度，它的蛇身会在这格停留这么多步
+
+    // 置换表：第step步蛇头在(y, x)、沿come方向走进来的局面，在本轮加深中的得分
+    struct Entry { int round; int value; };
+    Entry table[MAX_DEPTH + 1][MAXM][MAXN][4];
+    int search_round = 0;
+
+    // 第snake_idx条蛇第step步能否进入(y, x)的蛇身部分：自己的蛇身不挡自己
+    bool bodyBlocks(int y, int x, int step, int snake_idx) {
+        return vacate_owner[y][x] >= 0 && vacate_owner[y][x] != snake_idx && step < vacate_at[y][x];
+    }
+
+    // 第snake_idx条蛇的蛇头最早第几步能到各格：蛇身格子要等到空出来才能进入（不能原地等，到达时间按空出来的那一步算）
+    void buildReach(const GameState &state, int snake_idx, int reach[MAXM][MAXN]) {
+        static vector<vector<Point>> buckets;
+        const Snake &snake = state.snakes[snake_idx];
+        const Point &source = snake.get_head();
+        fill(&reach[0][0], &reach[0][0] + MAXM * MAXN, DIST_UNREACHABLE);
+        if (!Utils::boundCheck(source.y, source.x)) return;
+
+        for (auto &b : buckets) b.clear();
+        buckets.resize(1);
+        reach[source.y][source.x] = 0;
+        buckets[0].push_back(source);
+
+        for (size_t t = 0; t < buckets.size(); t++) {
+            for (size_t k = 0; k < buckets[t].size(); k++) {
+                const Point p = buckets[t][k];
+                if (reach[p.y][p.x] != (int)t) continue;
+                for (auto dir : validDirections) {
+                    const auto [ny, nx] = Utils::nextPos({p.y, p.x}, dir);
+                    if (!Utils::boundCheck(ny, nx) || map_item[ny][nx] == -4) continue;
+                    if (map_item[ny][nx] == -5 && !snake.has_key) continue;
+                    if (t == 0 && snake.body.size() > 1 && snake.body[1] == Point{ny, nx}) continue; // 不能掉头
+
+                    int arrive = (int)t + 1;
+                    if (bodyBlocks(ny, nx, arrive, snake_idx)) arrive = vacate_at[ny][nx];
+                    if (arrive >= reach[ny][nx]) continue;
+                    reach[ny][nx] = arrive;
+                    if ((int)buckets.size() <= arrive) buckets.resize(arrive + 1);
+                    buckets[arrive].push_back({ny, nx});
+                }
+            }
+        }
+    }
+
+    // 敌方蛇头扩展：每格取最早到达的敌方蛇
+    void buildEnemyReach(const GameState &state) {
+        static int reach[MAXM][MAXN];
+        fill(&enemy_reach[0][0], &enemy_reach[0][0] + MAXM * MAXN, DIST_UNREACHABLE);
+        fill(&reach_length[0][0], &reach_length[0][0] + MAXM * MAXN, 0);
+        for (int i = 0; i < (int)state.snakes.size(); i++) {
+            if (i == self_idx) continue;
+            buildReach(state, i, reach);
+            for (int y = 0; y < MAXM; y++) {
+                for (int x = 0; x < MAXN; x++) {
+                    if (reach[y][x] < enemy_reach[y][x]) {
+                        enemy_reach[y][x] = reach[y][x];
+                        reach_length[y][x] = state.snakes[i].length;
+                    }
+                }
+            }
+        }
+    }
+
+    void prepare(const GameState &state) {
+        self_idx = state.self_idx;
+        self_length = (int)state.get_self().body.size();
+        space_limit = max(self_length * 2, 16);
+        int current_tick = MAX_TICKS - state.remaining_ticks;
+        int ticks_to_shrink = state.next_shrink_tick - current_tick;
+        shrink_step = ticks_to_shrink > 0 ? ticks_to_shrink : INT_MAX;
+        int ticks_to_final = state.final_shrink_tick - current_tick;
+        final_step = ticks_to_final > 0 ? ticks_to_final : INT_MAX;
+        nodes = 0;
+        out_of_time = false;
+
+        // 蛇身第j节（蛇头为第0节）在长度减j步后空出来，多留一步余量：这条蛇吃到食物时蛇尾不动
+        memset(vacate_owner, -1, sizeof(vacate_owner));
+        memset(vacate_at, 0, sizeof(vacate_at));
+        for (int i = 0; i < (int)state.snakes.size(); i++) {
+            const auto &body = state.snakes[i].body;
+            for (int j = 0; j < (int)body.size(); j++) {
+                const Point &part = body[j];
+                if (!Utils::boundCheck(part.y, part.x)) continue;
+                int free_step = (int)body.size() - j + 1;
+                if (vacate_owner[part.y][part.x] < 0 || free_step > vacate_at[part.y][part.x]) {
+                    vacate_owner[part.y][part.x] = i;
+                    vacate_at[part.y][part.x] = free_step;
+                }
+            }
+        }
+        buildReach(state, self_idx, self_reach);
+        buildEnemyReach(state);
+    }
+
+    const SafeZoneBounds &zoneAt(const GameState &state, int step) {
+        if (step >= final_step) return state.final_safe_zone;
+        if (step >= shrink_step) return state.next_safe_zone;
+        return state.current_safe_zone;
+    }
+
+    // 第step步能否进入(y, x)
+    bool blockedAt(const GameState &state, int y, int x, int step) {
+        if (!Utils::boundCheck(y, x)) return true;
+        if (map_item[y][x] == -4) return true; // 墙
+        if (map_item[y][x] == -5 && !state.get_self().has_key) return true; // 没有钥匙时宝箱是障碍物
+        if (bodyBlocks(y, x, step, self_idx)) return true; // 还没缩走的敌方蛇身
+        // 敌方蛇头不比我们晚到的格子：同时到达会撞头，先到的话它的蛇身会在这格停留一段时间。
+        // 我们先到的格子算我们的地盘，不再假设敌方蛇会进来
+        if (enemy_reach[y][x] <= self_reach[y][x] &&
+            enemy_reach[y][x] <= step && step < enemy_reach[y][x] + reach_length[y][x]) return true;
+
+        const SafeZoneBounds &zone = zoneAt(state, step);
+        if (x < zone.x_min || x > zone.x_max || y < zone.y_min || y > zone.y_max) return true;
+        return false;
+    }
+
+    // 叶子结点的空间评估：第step步蛇头在pos，之后能走到的属于我们的格子数（比所有敌方蛇头都先到，与Territory同样的划分），最多数到space_limit
+    int spaceAt(const GameState &state, const Point &pos, int step) {
+        Scratch::begin();
+        Point *q = Scratch::queue_buf;
+        int q_head = 0, q_tail = 0;
+        q[q_tail++] = pos;
+        Scratch::mark(pos.y, pos.x, step);
+        while (q_head < q_tail && q_tail < space_limit) {
+            const Point cur = q[q_head++];
+            int next_step = Scratch::dist[cur.y][cur.x] + 1;
+            for (auto dir : validDirections) {
+                const auto [y, x] = Utils::nextPos({cur.y, cur.x}, dir);
+                if (Scratch::visited(y, x) || blockedAt(state, y, x, next_step)) continue;
+                if (min(next_step, self_reach[y][x]) >= enemy_reach[y][x]) continue; // 不是我们的地盘
+                Scratch::mark(y, x, next_step);
+                q[q_tail++] = {y, x};
+            }
+        }
+        return min(q_tail, space_limit);
+    }
+
+    int trapCost(int y, int x) { return map_item[y][x] == -2 ? TRAP_PENALTY : 0; }
+
+    // 第step步蛇头在pos、从蛇颈neck沿come方向走进来，搜索到第depth步的得分：
+    // 走得到第depth步时为叶子的空间评估减去沿途陷阱的扣分，走不到时为DEAD加上能走的步数
+    int search(const GameState &state, const Point &pos, const Point &neck, int come, int step, int depth) {
+        if ((++nodes & (CHECK_INTERVAL - 1)) == 0 && Deadline::expired()) out_of_time = true;
+        if (out_of_time) return DEAD;
+        if (step == depth) return spaceAt(state, pos, step);
+
+        Entry &entry = table[step][pos.y][pos.x][come];
+        if (entry.round == search_round) return entry.value;
+
+        int best = DEAD + step;
+        for (auto dir : validDirections) {
+            const auto [ny, nx] = Utils::nextPos({pos.y, pos.x}, dir);
+            if (neck == Point{ny, nx} || blockedAt(state, ny, nx, step + 1)) continue; // 不能掉头
+            int value = search(state, {ny, nx}, pos, Utils::dir2num(dir), step + 1, depth);
+            if (out_of_time) return DEAD;
+            if (value > DEAD + MAX_DEPTH) value -= trapCost(ny, nx);
+            best = max(best, value);
+        }
+        entry = {search_round, best};
+        return best;
+    }
+
+    // 从蛇头出发的第一步是不是掉头回到蛇颈
+    bool isReverse(const GameState &state, int y, int x) {
+        const Snake &self = state.get_self();
+        return self.body.size() > 1 && self.body[1] == Point{y, x};
+    }
+
+    // 不依赖启发式评估的保底走法：第一步不会撞死、前方空间最大的方向。需要先调用prepare()
+    int safeFallback(const GameState &state) {
+        const Point &head = state.get_self().get_head();
+        int best = state.get_self().direction, best_space = -1;
+
+        for (auto dir : validDirections) {
+            const auto [ny, nx] = Utils::nextPos({head.y, head.x}, dir);
+            if (isReverse(state, ny, nx) || blockedAt(state, ny, nx, 1)) continue;
+
+            // 从这一格出发、不经过蛇头能到的格子数，最多数到蛇长的两倍
+            int limit = max(self_length * 2, 8);
+            Scratch::begin();
+            Point *q = Scratch::queue_buf;
+            int q_head = 0, q_tail = 0;
+            Scratch::mark(head.y, head.x, 0);
+            q[q_tail++] = {ny, nx};
+            Scratch::mark(ny, nx, 1);
+            while (q_head < q_tail && q_tail < limit) {
+                const Point cur = q[q_head++];
+                int step = Scratch::dist[cur.y][cur.x] + 1;
+                for (auto next_dir : validDirections) {
+                    const auto [y, x] = Utils::nextPos({cur.y, cur.x}, next_dir);
+                    if (blockedAt(state, y, x, step) || Scratch::visited(y, x)) continue;
+                    Scratch::mark(y, x, step);
+                    q[q_tail++] = {y, x};
+                }
+            }
+
+            if (q_tail > best_space) {
+                best_space = q_tail;
+                best = Utils::dir2num(dir);
+            }
+        }
+        return best;
+    }
+
+    // 逐步加深的前瞻：每加深一轮重新给四个第一步打分，加深到MAX_DEPTH（或游戏结束）或时间用完为止，
+    // 时间用完时丢掉没搜完的这一轮，用最后一轮完整结果修正启发式决策：
+    // 启发式决策比最好的方向先走投无路，或者它留下的空间装不下蛇身而最好的方向装得下时，换成最好的方向
+    int refine(const GameState &state, int decision, int fallback) {
+        const Snake &self = state.get_self();
+        // 护盾指令和护盾期间的走法由启发式决定
+        if (decision < 0 || decision > 3) return decision;
+        if (self.shield_time > 0) return decision;
+
+        const Point &head = self.get_head();
+        const Point neck = self.body.size() > 1 ? self.body[1] : Point{-1, -1};
+        int max_depth = min(MAX_DEPTH, state.remaining_ticks);
+        int scores[4];
+        bool searched = false;
+
+        for (int depth = 1; depth <= max_depth; depth++) {
+            search_round++;
+            int result[4];
+            for (auto dir : validDirections) {
+                int d = Utils::dir2num(dir);
+                const auto [ny, nx] = Utils::nextPos({head.y, head.x}, dir);
+                if (neck == Point{ny, nx} || blockedAt(state, ny, nx, 1)) { result[d] = DEAD; continue; }
+                result[d] = search(state, {ny, nx}, head, d, 1, depth);
+                if (out_of_time) break;
+                if (result[d] > DEAD + MAX_DEPTH) result[d] -= trapCost(ny, nx);
+            }
+            if (out_of_time) break;
+            copy(result, result + 4, scores);
+            searched = true;
+        }
+        if (!searched) return decision;
+
+        // 同分时依次偏向启发式决策和保底走法
+        int best = decision;
+        if (scores[fallback] > scores[best]) best = fallback;
+        for (int d = 0; d < 4; d++) {
+            if (scores[d] > scores[best]) best = d;
+        }
+        if (best == decision) return decision;
+
+        bool decision_alive = scores[decision] > DEAD + MAX_DEPTH;
+        if (!decision_alive) return best;
+        if (scores[decision] < self_length && scores[best] >= self_length) return best;
+        return decision;
+    }
+}
+
+// 地盘保护：启发式选的方向走过去后我们独占的格子装不下蛇身、又比现在的地盘小时，
+// 改走基本合法方向里独占格子最多的一个（它要装得下蛇身才改）
+int keepEnoughTerritory(const GameState &state, int decision) {
+    if (decision < 0 || decision > 3) return decision;
+    const Snake &self = state.get_self();
+    const Point &head = self.get_head();
+
+    auto areaAfter = [&](Direction dir) {
+        const auto [ny, nx] = Utils::nextPos({head.y, head.x}, dir);
+        return territory.areaAfterMove(distance_fields, {ny, nx});
+    };
+
+    int decision_area = 0;
+    for (auto dir : validDirections) {
+        if (Utils::dir2num(dir) == decision) decision_area = areaAfter(dir);
+    }
+    if (decision_area >= self.length || decision_area >= territory.myArea()) return decision;
+
+    unordered_set<Direction> illegals = basicIllegalCheck(state);
+    int best = decision, best_area = decision_area;
+    for (auto dir : validDirections) {
+        if (illegals.count(dir) > 0) continue;
+        int area = areaAfter(dir);
+        if (area > best_area) { best_area = area; best = Utils::dir2num(dir); }
+    }
+    return best_area >= self.length ? best : decision;
+}
+
+// 带截止时间的决策：先算出保底走法，再做启发式决策，剩下的时间用逐步加深的生存前瞻检查和修正，
+// 任何一步之后时间用完都直接返回手上最好的走法
+int judge(const GameState &state)
+{
+    Lookahead::prepare(state);
+    int fallback = Lookahead::safeFallback(state);
+    if (Deadline::expired()) return fallback;
+
+    int decision = judgeByHeuristics(state);
+    if (Deadline::expired()) return decision;
+
+    decision = keepEnoughTerritory(state, decision);
+    if (Deadline::expired()) return decision;
+
+    return Lookahead::refine(state, decision, fallback);
+}
+
 int main() {
+  // 从进程入口开始计算本tick的CPU时间
+  Deadline::start();
+
   // 读取当前 tick 的所有游戏状态
   GameState current_state;
   read_game_state(current_state);